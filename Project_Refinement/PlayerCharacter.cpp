@@ -2,6 +2,9 @@
 
 #include "PlayerCharacter.h"
 #include "TerminalActor.h"
+#include "TerminalBoundWidget.h"
+#include "TerminalSubsystem.h"
+#include "TimerManager.h"
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GameFramework/PlayerController.h"
@@ -9,15 +12,22 @@
 #include "Blueprint/UserWidget.h"
 #include "Engine/World.h"
 #include "Components/WidgetInteractionComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "DrawDebugHelpers.h"
+#include "EnhancedInputComponent.h"
+#include "EnhancedInputSubsystems.h"
+#include "Engine/LocalPlayer.h"
+#include "InputMappingContext.h"
 
 /**
  * Constructor - Sets up the first-person camera and mesh.
  */
 APlayerCharacter::APlayerCharacter()
 {
+	// Tick only runs while seated (it flushes trackball input), see EnterTerminalInputMode
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// ========================================
 	// First-Person Camera Setup
@@ -48,11 +58,16 @@ void APlayerCharacter::StandUpFromTerminal()
 		return;
 	}
 
+	HideTerminalWidget();
+
 	// Notify the terminal that the player is leaving
 	if (ATerminalActor* Term = Cast<ATerminalActor>(LastTerminalUsed))
 	{
-		Term->OnPlayerExit();
+		Term->OnSensorProximityChanged.RemoveDynamic(this, &APlayerCharacter::HandleSensorProximityChanged);
+		// Also sends the terminal to sleep
+		Term->NotifyPlayerExit();
 	}
+	SensorStressLevel = 0;
 
 	// ========================================
 	// Switch Camera Back to Player
@@ -69,8 +84,12 @@ void APlayerCharacter::StandUpFromTerminal()
 	// ========================================
 	// Clear Terminal State
 	// ========================================
+	ExitTerminalInputMode();
 	bUsingTerminal = false;
 	LastTerminalUsed = nullptr;
+
+	// Walking again - look for terminals
+	StartFocusUpdates();
 }
 
 /**
@@ -79,6 +98,27 @@ void APlayerCharacter::StandUpFromTerminal()
 void APlayerCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+
+	PrewarmTerminalWidgets();
+	StartFocusUpdates();
+}
+
+/**
+ * Drops the pooled widgets with the character.
+ */
+void APlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (const TPair<TSubclassOf<UUserWidget>, UUserWidget*>& Entry : TerminalWidgetPool)
+	{
+		if (Entry.Value)
+		{
+			Entry.Value->RemoveFromParent();
+		}
+	}
+	TerminalWidgetPool.Empty();
+	TerminalWidget = nullptr;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -124,11 +164,61 @@ void APlayerCharacter::StopScrolling()
 }
 
 /**
- * Called every frame.
+ * Called every frame while seated.
+ * Sends the trackball movement gathered this frame to the terminal in one call,
+ * so the grid scrolls (and its viewport updates) at most once per frame.
  */
 void APlayerCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	if (PendingTrackballDelta.IsZero())
+	{
+		return;
+	}
+
+	if (ATerminalActor* Term = Cast<ATerminalActor>(LastTerminalUsed))
+	{
+		const FVector2D Scroll = PendingTrackballDelta * TrackballSensitivity;
+		Term->ApplyTrackballInput(Scroll.X, Scroll.Y);
+	}
+	PendingTrackballDelta = FVector2D::ZeroVector;
+}
+
+/**
+ * Enables terminal-mode input: the terminal mapping context and ticking.
+ */
+void APlayerCharacter::EnterTerminalInputMode()
+{
+	PendingTrackballDelta = FVector2D::ZeroVector;
+	SetActorTickEnabled(true);
+
+	APlayerController* PC = Cast<APlayerController>(GetController());
+	if (PC && TerminalMappingContext)
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
+		{
+			InputSubsystem->AddMappingContext(TerminalMappingContext, TerminalMappingPriority);
+		}
+	}
+}
+
+/**
+ * Disables terminal-mode input again.
+ */
+void APlayerCharacter::ExitTerminalInputMode()
+{
+	PendingTrackballDelta = FVector2D::ZeroVector;
+	SetActorTickEnabled(false);
+
+	APlayerController* PC = Cast<APlayerController>(GetController());
+	if (PC && TerminalMappingContext)
+	{
+		if (UEnhancedInputLocalPlayerSubsystem* InputSubsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PC->GetLocalPlayer()))
+		{
+			InputSubsystem->RemoveMappingContext(TerminalMappingContext);
+		}
+	}
 }
 
 /**
@@ -166,8 +256,17 @@ void APlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 	PlayerInputComponent->BindAction("ScrollModifier", IE_Released, this, &APlayerCharacter::StopScrolling);
 	
 	// Scroll axes (mouse movement when ScrollModifier is held)
-	PlayerInputComponent->BindAxis("TerminalScroll_X", this, &APlayerCharacter::InputScrollX);
-	PlayerInputComponent->BindAxis("TerminalScroll_Y", this, &APlayerCharacter::InputScrollY);
+	// Enhanced Input when an action is assigned, legacy axes otherwise
+	UEnhancedInputComponent* EnhancedInput = Cast<UEnhancedInputComponent>(PlayerInputComponent);
+	if (EnhancedInput && TerminalScrollAction)
+	{
+		EnhancedInput->BindAction(TerminalScrollAction, ETriggerEvent::Triggered, this, &APlayerCharacter::InputTrackball);
+	}
+	else
+	{
+		PlayerInputComponent->BindAxis("TerminalScroll_X", this, &APlayerCharacter::InputScrollX);
+		PlayerInputComponent->BindAxis("TerminalScroll_Y", this, &APlayerCharacter::InputScrollY);
+	}
 }
 
 // ========================================
@@ -228,46 +327,36 @@ void APlayerCharacter::Turn(float Rate)
 // ========================================
 
 /**
- * Handles horizontal trackball scroll input.
- * Sends mouse X movement to the terminal for grid scrolling.
+ * Handles the 2D trackball action (Enhanced Input).
+ * Movement is only gathered here; Tick forwards it once per frame.
+ */
+void APlayerCharacter::InputTrackball(const FInputActionValue& Value)
+{
+	if (bUsingTerminal)
+	{
+		PendingTrackballDelta += Value.Get<FVector2D>();
+	}
+}
+
+/**
+ * Handles horizontal trackball scroll input (legacy axis).
  */
 void APlayerCharacter::InputScrollX(float AxisValue)
 {
-	// Only process if using terminal and there's actual input
-	if (bUsingTerminal && LastTerminalUsed && AxisValue != 0.f)
+	if (bUsingTerminal)
 	{
-		if (ATerminalActor* Term = Cast<ATerminalActor>(LastTerminalUsed))
-		{
-			// ========================================
-			// Sensitivity Multiplier
-			// ========================================
-			// Reduce to 0.1 (or even 0.05) to slow down scrolling
-			// Higher values = faster, more sensitive scrolling
-			// Lower values = slower, more precise scrolling
-			float Sensitivity = 0.1f;
-			
-			// Send X input to terminal (Y component is 0)
-			Term->ApplyTrackballInput(AxisValue * Sensitivity, 0.f);
-		}
+		PendingTrackballDelta.X += AxisValue;
 	}
 }
 
 /**
- * Handles vertical trackball scroll input.
- * Sends mouse Y movement to the terminal for grid scrolling.
+ * Handles vertical trackball scroll input (legacy axis).
  */
 void APlayerCharacter::InputScrollY(float AxisValue)
 {
-	if (bUsingTerminal && LastTerminalUsed && AxisValue != 0.f)
+	if (bUsingTerminal)
 	{
-		if (ATerminalActor* Term = Cast<ATerminalActor>(LastTerminalUsed))
-		{
-			// Same sensitivity as X axis for consistent feel
-			float Sensitivity = 0.1f;
-			
-			// Send Y input to terminal (X component is 0)
-			Term->ApplyTrackballInput(0.f, AxisValue * Sensitivity);
-		}
+		PendingTrackballDelta.Y += AxisValue;
 	}
 }
 
@@ -301,51 +390,311 @@ void APlayerCharacter::Interact()
 	// Case 2: Try to Sit Down at Terminal
 	// ========================================
 	
-	// Perform raycast from camera to find terminals
-	FHitResult Hit;
-	FVector Start = FirstPersonCamera->GetComponentLocation();
-	FVector End = Start + FirstPersonCamera->GetForwardVector() * InteractRange;
-
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this); // Don't hit ourselves
-
-	// Raycast on the custom interaction channel (ECC_GameTraceChannel1)
-	// Make sure your terminals are set to block this channel!
-	if (GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_GameTraceChannel1, Params))
+	// The focus timer already knows which terminal we're looking at - no trace needed
+	ATerminalActor* HitTerminal = FocusedTerminal.Get();
+	
+	// ========================================
+	// Power Check (Optional)
+	// ========================================
+	// TODO: Check if HitTerminal->IsPoweredOn() before sitting
+	// This prevents interacting with unpowered terminals
+	
+	if (HitTerminal)
 	{
-		ATerminalActor* HitTerminal = Cast<ATerminalActor>(Hit.GetActor());
-		
+		// Store reference to this terminal
+		LastTerminalUsed = HitTerminal;
+
 		// ========================================
-		// Power Check (Optional)
+		// Switch Camera to Terminal View
 		// ========================================
-		// TODO: Check if HitTerminal->IsPoweredOn() before sitting
-		// This prevents interacting with unpowered terminals
+		// Smooth 1 second blend to terminal camera
+		PC->SetViewTargetWithBlend(HitTerminal, 1.0f);
 		
-		if (HitTerminal)
+		// ========================================
+		// Set Input Mode for Terminal Use
+		// ========================================
+		// GameAndUI allows both mouse cursor and game input
+		PC->SetInputMode(FInputModeGameAndUI());
+		PC->bShowMouseCursor = true; // Show cursor for clicking UI
+
+		// ========================================
+		// Notify Terminal of Player Interaction
+		// ========================================
+		// Wakes the selected terminal (and puts any other one to sleep)
+		HitTerminal->NotifyPlayerInteract();
+
+		// Listen for sensor changes instead of polling the terminal every frame
+		SensorStressLevel = HitTerminal->GetSensorThresholdLevel();
+		HitTerminal->OnSensorProximityChanged.AddUniqueDynamic(this, &APlayerCharacter::HandleSensorProximityChanged);
+
+		ShowTerminalWidget(HitTerminal);
+
+		// Update state
+		bUsingTerminal = true;
+		EnterTerminalInputMode();
+
+		// No hover highlights while seated
+		StopFocusUpdates();
+	}
+}
+
+// ========================================
+// TERMINAL WIDGET POOL
+// ========================================
+
+/**
+ * Builds the terminal widgets up front.
+ * Needs the owning player controller; without one (not possessed yet) the
+ * widgets are simply created on the first sit-down instead.
+ */
+void APlayerCharacter::PrewarmTerminalWidgets()
+{
+	if (!Cast<APlayerController>(GetController()) || !IsLocallyControlled())
+	{
+		return;
+	}
+
+	TArray<TSubclassOf<UUserWidget>, TInlineAllocator<4>> Classes;
+	Classes.AddUnique(TerminalWidgetClass);
+	for (const TSubclassOf<UUserWidget>& WidgetClass : PrewarmWidgetClasses)
+	{
+		Classes.AddUnique(WidgetClass);
+	}
+
+	// Terminals placed in the level register before any pawn begins play
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+	{
+		for (const TWeakObjectPtr<ATerminalActor>& Entry : TerminalManager->GetRegisteredTerminals())
 		{
-			// Store reference to this terminal
-			LastTerminalUsed = HitTerminal;
-
-			// ========================================
-			// Switch Camera to Terminal View
-			// ========================================
-			// Smooth 1 second blend to terminal camera
-			PC->SetViewTargetWithBlend(HitTerminal, 1.0f);
-			
-			// ========================================
-			// Set Input Mode for Terminal Use
-			// ========================================
-			// GameAndUI allows both mouse cursor and game input
-			PC->SetInputMode(FInputModeGameAndUI());
-			PC->bShowMouseCursor = true; // Show cursor for clicking UI
-
-			// ========================================
-			// Notify Terminal of Player Interaction
-			// ========================================
-			HitTerminal->OnPlayerInteract(); 
-
-			// Update state
-			bUsingTerminal = true;
+			if (const ATerminalActor* Terminal = Entry.Get())
+			{
+				Classes.AddUnique(Terminal->SeatedWidgetClass);
+			}
 		}
 	}
-}
\ No newline at end of file
+
+	for (const TSubclassOf<UUserWidget>& WidgetClass : Classes)
+	{
+		AcquireTerminalWidget(WidgetClass);
+	}
+}
+
+/**
+ * Pool lookup with lazy creation.
+ * New widgets go straight into the viewport collapsed: later sit-downs only flip
+ * visibility instead of rebuilding the Slate tree.
+ */
+UUserWidget* APlayerCharacter::AcquireTerminalWidget(TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (!WidgetClass)
+	{
+		return nullptr;
+	}
+
+	if (UUserWidget** Pooled = TerminalWidgetPool.Find(WidgetClass))
+	{
+		if (*Pooled)
+		{
+			return *Pooled;
+		}
+	}
+
+	APlayerController* PC = Cast<APlayerController>(GetController());
+	if (!PC)
+	{
+		return nullptr;
+	}
+
+	UUserWidget* Widget = CreateWidget<UUserWidget>(PC, WidgetClass);
+	if (Widget)
+	{
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		Widget->AddToViewport();
+		TerminalWidgetPool.Add(WidgetClass, Widget);
+	}
+	return Widget;
+}
+
+/**
+ * Shows the terminal's widget (or the default one) and binds it to the terminal.
+ */
+void APlayerCharacter::ShowTerminalWidget(ATerminalActor* Terminal)
+{
+	HideTerminalWidget();
+
+	const TSubclassOf<UUserWidget> WidgetClass = (Terminal && Terminal->SeatedWidgetClass) ? Terminal->SeatedWidgetClass : TerminalWidgetClass;
+	TerminalWidget = AcquireTerminalWidget(WidgetClass);
+	if (!TerminalWidget)
+	{
+		return;
+	}
+
+	// Something else may have removed it from the viewport since it was pooled
+	if (!TerminalWidget->IsInViewport())
+	{
+		TerminalWidget->AddToViewport();
+	}
+
+	if (TerminalWidget->Implements<UTerminalBoundWidget>())
+	{
+		ITerminalBoundWidget::Execute_BindToTerminal(TerminalWidget, Terminal);
+	}
+	TerminalWidget->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+}
+
+/**
+ * Collapses the shown widget; a collapsed widget costs no layout or paint.
+ */
+void APlayerCharacter::HideTerminalWidget()
+{
+	if (!TerminalWidget)
+	{
+		return;
+	}
+
+	if (TerminalWidget->Implements<UTerminalBoundWidget>())
+	{
+		ITerminalBoundWidget::Execute_UnbindFromTerminal(TerminalWidget);
+	}
+	TerminalWidget->SetVisibility(ESlateVisibility::Collapsed);
+	TerminalWidget = nullptr;
+}
+
+// ========================================
+// TERMINAL FOCUS
+// ========================================
+
+/**
+ * Starts updating the focused terminal at FocusUpdateInterval.
+ */
+void APlayerCharacter::StartFocusUpdates()
+{
+	GetWorldTimerManager().SetTimer(FocusTimerHandle, this, &APlayerCharacter::UpdateTerminalFocus, FocusUpdateInterval, true);
+	UpdateTerminalFocus();
+}
+
+/**
+ * Stops focus updates and drops the current focus.
+ */
+void APlayerCharacter::StopFocusUpdates()
+{
+	GetWorldTimerManager().ClearTimer(FocusTimerHandle);
+	SetFocusedTerminal(nullptr);
+}
+
+/**
+ * Picks the terminal to focus.
+ * 
+ * Every terminal registered with the terminal manager is checked against a view
+ * cone first: its screen must be within InteractRange and within FocusConeHalfAngle
+ * of the view direction. The one closest to the center of the view wins, and a
+ * single line-of-sight trace to its screen then rejects it if something is in the way.
+ */
+void APlayerCharacter::UpdateTerminalFocus()
+{
+	UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>();
+	if (!TerminalManager || !FirstPersonCamera)
+	{
+		SetFocusedTerminal(nullptr);
+		return;
+	}
+
+	const FVector ViewLocation = FirstPersonCamera->GetComponentLocation();
+	const FVector ViewDirection = FirstPersonCamera->GetForwardVector();
+	const float RangeSquared = FMath::Square(InteractRange);
+	const float MinCos = FMath::Cos(FMath::DegreesToRadians(FocusConeHalfAngle));
+
+	ATerminalActor* BestTerminal = nullptr;
+	FVector BestTarget = FVector::ZeroVector;
+	float BestCos = MinCos;
+
+	for (const TWeakObjectPtr<ATerminalActor>& Entry : TerminalManager->GetRegisteredTerminals())
+	{
+		ATerminalActor* Terminal = Entry.Get();
+		if (!Terminal)
+		{
+			continue;
+		}
+
+		// Aim at the middle of the screen, not the actor pivot (usually on the floor)
+		const FVector Target = Terminal->CRTMonitor ? Terminal->CRTMonitor->Bounds.Origin : Terminal->GetActorLocation();
+		const FVector ToTerminal = Target - ViewLocation;
+		const float DistSquared = ToTerminal.SizeSquared();
+		if (DistSquared > RangeSquared || DistSquared <= KINDA_SMALL_NUMBER)
+		{
+			continue;
+		}
+
+		// Cosine of the angle between the view and the terminal
+		const float Cos = FVector::DotProduct(ToTerminal, ViewDirection) * FMath::InvSqrt(DistSquared);
+		if (Cos >= BestCos)
+		{
+			BestCos = Cos;
+			BestTerminal = Terminal;
+			BestTarget = Target;
+		}
+	}
+
+	// Only the winner is traced; a blocking hit on anything but the terminal hides it
+	if (BestTerminal)
+	{
+		FHitResult Hit;
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(TerminalFocus));
+		Params.AddIgnoredActor(this);
+
+		if (GetWorld()->LineTraceSingleByChannel(Hit, ViewLocation, BestTarget, ECC_Visibility, Params)
+			&& Hit.GetActor() != BestTerminal)
+		{
+			BestTerminal = nullptr;
+		}
+	}
+
+	SetFocusedTerminal(BestTerminal);
+}
+
+/**
+ * Updates the cached focus and notifies listeners when it changes.
+ */
+void APlayerCharacter::SetFocusedTerminal(ATerminalActor* NewFocus)
+{
+	ATerminalActor* OldFocus = FocusedTerminal.Get();
+	if (OldFocus == NewFocus)
+	{
+		return;
+	}
+
+	FocusedTerminal = NewFocus;
+
+	if (OldFocus)
+	{
+		OnTerminalUnfocused.Broadcast(OldFocus);
+	}
+	if (NewFocus)
+	{
+		OnTerminalFocused.Broadcast(NewFocus);
+	}
+}
+
+// ========================================
+// CAMERA EFFECTS
+// ========================================
+
+/**
+ * Reacts to the seated terminal's proximity sensor crossing a threshold.
+ * Only escalation shakes the camera; calming down is silent.
+ */
+void APlayerCharacter::HandleSensorProximityChanged(float ProximityValue, int32 ThresholdLevel)
+{
+	const bool bStressRising = ThresholdLevel > SensorStressLevel;
+	SensorStressLevel = ThresholdLevel;
+
+	if (!bStressRising || !ShakeCameraClass)
+	{
+		return;
+	}
+
+	if (APlayerController* PC = Cast<APlayerController>(GetController()))
+	{
+		PC->ClientStartCameraShake(ShakeCameraClass, ProximityValue);
+	}
+}
@@ -6,8 +6,20 @@
 #include "GameFramework/Character.h"
 #include "Camera/CameraComponent.h"
 #include "Components/WidgetInteractionComponent.h"
+#include "InputActionValue.h"
 #include "PlayerCharacter.generated.h"
 
+class UInputMappingContext;
+class UInputAction;
+class ATerminalActor;
+
+/**
+ * Broadcast when the terminal the player is looking at changes.
+ *
+ * @param Terminal - The terminal that gained or lost focus
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTerminalFocusChanged, ATerminalActor*, Terminal);
+
 /**
  * Player Character for the Terminal Refinement game.
  * 
@@ -21,6 +33,10 @@
  * Gameplay States:
  * - Walking: Normal first-person controls, can look around and interact
  * - Using Terminal: Camera locked to terminal, mouse controls UI and trackball scrolling
+ *
+ * The character only ticks while seated. Trackball input (Enhanced Input, or the
+ * legacy TerminalScroll axes as a fallback) is summed during the frame and
+ * forwarded to the terminal in a single call from Tick.
  */
 UCLASS()
 class PROJECT_REFINEMENT_API APlayerCharacter : public ACharacter
@@ -40,8 +56,10 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public: 
+	/** Forwards this frame's trackball movement to the terminal (only ticks while seated) */
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
@@ -68,19 +86,27 @@ public:
 	UWidgetInteractionComponent* WidgetInteractor;
 	
 	/**
-	 * The widget class to spawn when using a terminal.
+	 * The widget class to show when using a terminal.
 	 * Set this in Blueprint to your terminal UI widget.
+	 * A terminal's SeatedWidgetClass takes precedence over it.
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
 	TSubclassOf<UUserWidget> TerminalWidgetClass;
 
 	/**
-	 * Active instance of the terminal widget.
-	 * Spawned when sitting down, destroyed when standing up.
+	 * Active instance of the terminal widget, or nullptr while walking.
+	 * Taken from the widget pool when sitting down, collapsed (not destroyed) when standing up.
 	 */
 	UPROPERTY()
 	UUserWidget* TerminalWidget;
 
+	/**
+	 * Extra widget classes created at BeginPlay, on top of TerminalWidgetClass and the
+	 * SeatedWidgetClass of every terminal already in the level.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
+	TArray<TSubclassOf<UUserWidget>> PrewarmWidgetClasses;
+
 	// ========================================
 	// Terminal State
 	// ========================================
@@ -110,6 +136,37 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Camera")
 	TSubclassOf<UCameraShakeBase> ShakeCameraClass;
 
+	/**
+	 * Called by the seated terminal when its proximity sensor crosses a threshold.
+	 * Plays ShakeCameraClass (scaled by proximity) whenever the stress level rises.
+	 */
+	UFUNCTION()
+	void HandleSensorProximityChanged(float ProximityValue, int32 ThresholdLevel);
+
+	// ========================================
+	// Terminal Focus
+	// ========================================
+
+	/** Fired when the player starts looking at a terminal in interaction range (use for hover highlights) */
+	UPROPERTY(BlueprintAssignable, Category = "Interaction")
+	FOnTerminalFocusChanged OnTerminalFocused;
+
+	/** Fired when the focused terminal is no longer looked at, out of range, or the player sits down */
+	UPROPERTY(BlueprintAssignable, Category = "Interaction")
+	FOnTerminalFocusChanged OnTerminalUnfocused;
+
+	/** Terminal currently in focus (what Interact would sit at), or nullptr */
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	ATerminalActor* GetFocusedTerminal() const { return FocusedTerminal.Get(); }
+
+	/** Seconds between focus updates while walking (0.1 = 10 Hz) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction", meta = (ClampMin = "0.01"))
+	float FocusUpdateInterval = 0.1f;
+
+	/** Half-angle of the view cone a terminal must be inside to gain focus (degrees) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+	float FocusConeHalfAngle = 20.f;
+
 private:
 	// ========================================
 	// Movement Input Handlers
@@ -145,7 +202,7 @@ private:
 	
 	/**
 	 * Handles the interact key press.
-	 * When standing: Raycasts to find and sit at a terminal
+	 * When standing: Sits at the focused terminal (see UpdateTerminalFocus)
 	 * When seated: Stands up from the terminal
 	 */
 	void Interact();
@@ -155,13 +212,13 @@ private:
 	// ========================================
 	
 	/**
-	 * Handles horizontal trackball scroll input.
+	 * Legacy horizontal trackball axis, adds to this frame's total.
 	 * Only active when using a terminal.
 	 */
 	void InputScrollX(float AxisValue);
 	
 	/**
-	 * Handles vertical trackball scroll input.
+	 * Legacy vertical trackball axis, adds to this frame's total.
 	 * Only active when using a terminal.
 	 */
 	void InputScrollY(float AxisValue);
@@ -191,4 +248,94 @@ private:
 	/** Maximum distance for terminal interaction raycast */
 	UPROPERTY(EditAnywhere)
 	float InteractRange = 300.f;
+
+	/**
+	 * Scales raw trackball/mouse movement into terminal scroll input.
+	 * Lower values = slower, more precise scrolling.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Input|Terminal", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float TrackballSensitivity = 0.1f;
+
+	// ========================================
+	// Enhanced Input (Terminal Mode)
+	// ========================================
+
+	/** Mapping context added while seated at a terminal */
+	UPROPERTY(EditDefaultsOnly, Category = "Input|Terminal", meta = (AllowPrivateAccess = "true"))
+	UInputMappingContext* TerminalMappingContext = nullptr;
+
+	/** Priority of TerminalMappingContext over the walking contexts */
+	UPROPERTY(EditDefaultsOnly, Category = "Input|Terminal", meta = (AllowPrivateAccess = "true"))
+	int32 TerminalMappingPriority = 1;
+
+	/**
+	 * Axis2D action for trackball scrolling.
+	 * When unset, the legacy TerminalScroll_X / TerminalScroll_Y axes are used instead.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Input|Terminal", meta = (AllowPrivateAccess = "true"))
+	UInputAction* TerminalScrollAction = nullptr;
+
+	/** Enhanced Input handler - adds the 2D delta to this frame's total */
+	void InputTrackball(const FInputActionValue& Value);
+
+	/** Turns on ticking and the terminal mapping context when sitting down */
+	void EnterTerminalInputMode();
+
+	/** Turns them off again when standing up */
+	void ExitTerminalInputMode();
+
+	// ========================================
+	// Terminal Widget Pool
+	// ========================================
+
+	/**
+	 * Creates (but does not show) one widget per terminal UI class, so the first
+	 * sit-down doesn't pay for building the widget tree.
+	 */
+	void PrewarmTerminalWidgets();
+
+	/** Returns the pooled widget of a class, creating and adding it (collapsed) to the viewport on first use */
+	UUserWidget* AcquireTerminalWidget(TSubclassOf<UUserWidget> WidgetClass);
+
+	/** Shows the widget for Terminal and binds it (see ITerminalBoundWidget) */
+	void ShowTerminalWidget(ATerminalActor* Terminal);
+
+	/** Unbinds and collapses the shown widget; it stays pooled for the next sit-down */
+	void HideTerminalWidget();
+
+	/** One live widget per class, reused across sit-downs */
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<UUserWidget>, UUserWidget*> TerminalWidgetPool;
+
+	// ========================================
+	// Terminal Focus
+	// ========================================
+
+	/**
+	 * Finds the registered terminal closest to the view direction within
+	 * InteractRange that is in line of sight, and updates the focus, firing
+	 * the focus events on change.
+	 */
+	void UpdateTerminalFocus();
+
+	/** Changes the focused terminal, firing OnTerminalUnfocused / OnTerminalFocused */
+	void SetFocusedTerminal(ATerminalActor* NewFocus);
+
+	/** Starts the throttled focus timer (walking) */
+	void StartFocusUpdates();
+
+	/** Stops it and clears the focus (seated) */
+	void StopFocusUpdates();
+
+	/** Timer driving UpdateTerminalFocus */
+	FTimerHandle FocusTimerHandle;
+
+	/** Cached result of the last focus update */
+	TWeakObjectPtr<ATerminalActor> FocusedTerminal;
+
+	/** Trackball movement gathered since the last Tick (unscaled) */
+	FVector2D PendingTrackballDelta = FVector2D::ZeroVector;
+
+	/** Last sensor threshold level reported by the seated terminal */
+	int32 SensorStressLevel = 0;
 };
\ No newline at end of file
@@ -1,6 +1,34 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Project_Refinement.h"
+#include "TerminalStats.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogTerminal);
+
+DEFINE_STAT(STAT_TerminalGenerateGrid);
+DEFINE_STAT(STAT_TerminalBuildGridStore);
+DEFINE_STAT(STAT_TerminalMaterializeSector);
+DEFINE_STAT(STAT_TerminalSensorQuery);
+DEFINE_STAT(STAT_TerminalScroll);
+DEFINE_STAT(STAT_TerminalSyncViewport);
+DEFINE_STAT(STAT_TerminalDropScoring);
+DEFINE_STAT(STAT_TerminalSnakeSearch);
+DEFINE_STAT(STAT_TerminalStartDay);
+DEFINE_STAT(STAT_TerminalEndDay);
+DEFINE_STAT(STAT_TerminalRunJobs);
+DEFINE_STAT(STAT_TerminalScrollEvents);
+DEFINE_STAT(STAT_TerminalGridScrolledBroadcasts);
+DEFINE_STAT(STAT_TerminalSensorQueries);
+DEFINE_STAT(STAT_TerminalDenseSensorQueries);
+DEFINE_STAT(STAT_TerminalEventsPosted);
+DEFINE_STAT(STAT_TerminalEventsDispatched);
+DEFINE_STAT(STAT_TerminalJobSlices);
+DEFINE_STAT(STAT_TerminalJobBudgetOverruns);
+DEFINE_STAT(STAT_TerminalCount);
+DEFINE_STAT(STAT_TerminalJobsPending);
+DEFINE_STAT(STAT_TerminalGridMemory);
+DEFINE_STAT(STAT_TerminalGridMemoryLargest);
+DEFINE_STAT(STAT_TerminalGridMemoryActive);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Project_Refinement, "Project_Refinement" );
@@ -4,3 +4,5 @@
 
 #include "CoreMinimal.h"
 
+/** Log category for the refinement terminal (grid generation, sensors, day flow) */
+DECLARE_LOG_CATEGORY_EXTERN(LogTerminal, Log, All);
@@ -1,11 +1,23 @@
 #include "TerminalActor.h"
+#include "Project_Refinement.h"
+#include "TerminalSubsystem.h"
+#include "TerminalSaveGame.h"
+#include "TerminalStats.h"
+#include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
 #include "AudioMixerBlueprintLibrary.h"
 #include "PlayerCharacter.h"
 #include "Math/UnrealMathUtility.h"
 #include "Camera/CameraComponent.h"
 #include "Components/WidgetComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "RHI.h"
 #include "Algo/RandomShuffle.h"
 #include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
+#include "Misc/FileHelper.h"
 
 /**
  * Constructor - Initializes all components and default values.
@@ -14,6 +26,10 @@ ATerminalActor::ATerminalActor()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
+	// Seed, eaten tiles, view and bars replicate; the grid is rebuilt on each client
+	bReplicates = true;
+	TileDeltas.Owner = this;
+
 	// ========================================
 	// Component Setup
 	// ========================================
@@ -34,16 +50,19 @@ ATerminalActor::ATerminalActor()
 	GridNumbers.Init(0, InitialSize);
 	ProgressBars.Init(0.f, 4);
 	HighlightedPrimes.Init(false, InitialSize);
-	ScaryActive.Init(false, InitialSize);
 	
 	// Cooldown system initialization
 	bBarCoolingDown.Init(false, 4);
 	BarCooldownRemaining.Init(0.f, 4);
+	BarCooldownTimers.SetNum(4);
+	BarCooldownStartTimes.Init(0.f, 4);
+	BarCooldownDurations.Init(0.f, 4);
 
 	// ========================================
 	// Default Settings
 	// ========================================
 	MaxSensorDistance = 15.0f;
+	SensorThresholds = { 0.25f, 0.5f, 0.75f };
 	ScrollX = 500;  // Start in middle of 1000x1000 grid
 	ScrollY = 500;
 }
@@ -54,7 +73,55 @@ ATerminalActor::ATerminalActor()
 void ATerminalActor::BeginPlay()
 {
 	Super::BeginPlay();
-	GenerateGrid();
+
+	// Clients build their grid from the replicated seed (OnRep_ReplicatedGrid)
+	if (HasAuthority())
+	{
+		if (bRandomizeDaySeed)
+		{
+			DaySeed = FMath::Rand();
+		}
+		GenerateGrid();
+	}
+
+	// The manager sends every terminal the player isn't using to sleep
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+	{
+		TerminalManager->RegisterTerminal(this);
+	}
+	if (bDormant)
+	{
+		SetScreenRedrawTime(IdleScreenRedrawTime);
+	}
+}
+
+/**
+ * Called when the terminal is removed from the world.
+ */
+void ATerminalActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	Recorder.Reset();
+	Replayer.Reset();
+
+	// Nothing queued for this terminal is wanted anymore (running workers finish on their own)
+	if (UTerminalJobScheduler* Scheduler = GetJobScheduler())
+	{
+		Scheduler->CancelJobs(this);
+	}
+	NextDayJob.Reset();
+	WarmupJob.Reset();
+	CompactJob.Reset();
+
+	// Release the grid first so the manager can drop cache entries nobody uses
+	GridStore.Reset();
+	NextDayGrid.Reset();
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+	{
+		TerminalManager->UnregisterTerminal(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // ========================================
@@ -62,555 +129,2863 @@ void ATerminalActor::BeginPlay()
 // ========================================
 
 /**
- * Generates the complete global grid (1000x1000) with random numbers.
+ * Generates the complete global grid (1000x1000) from DaySeed.
  * Also spawns "scary" numbers in a sector pattern (one per 50x50 block).
  */
 void ATerminalActor::GenerateGrid()
 {
-	UE_LOG(LogTemp, Warning, TEXT("!!! GenerateGrid is STARTING !!!"));
-	
-	// Calculate total size of the global grid
-	const int32 TotalGlobalCount = GlobalMapWidth * GlobalMapHeight;
-	
-	// Initialize arrays to correct size
-	GlobalGridNumbers.Init(0, TotalGlobalCount);
-	ScaryActive.Init(false, TotalGlobalCount);
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalGenerateGrid, "Terminal.GenerateGrid");
 
-	// ========================================
-	// Step 1: Fill Grid with Random Numbers (1-9)
-	// ========================================
-	for (int32 i = 0; i < TotalGlobalCount; ++i)
+	UE_LOG(LogTerminal, Log, TEXT("GenerateGrid starting (seed %d, %dx%d)"), DaySeed, GlobalMapWidth, GlobalMapHeight);
+
+	ResolveMapDimensions();
+
+	// Build numbers and scary tiles from the seed
+	// (Init inside also selects the modulo or mask wrap path for the map)
+	// Terminals on the same seed share one generated map through the manager
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
 	{
-		GlobalGridNumbers[i] = FMath::RandRange(1, 9);
+		TerminalManager->AcquireGrid(DaySeed, GlobalMapWidth, GlobalMapHeight, GridMode, GridStore);
 	}
-
-	// ========================================
-	// Step 2: Spawn Scary Numbers (Sector Pattern)
-	// ========================================
-	// Divide the grid into 50x50 sectors and spawn one scary number per sector
-	// This ensures even distribution across the infinite grid
-	int32 SectorSize = 50; 
-	
-	for (int32 y = 0; y < GlobalMapHeight; y += SectorSize)
+	else
 	{
-		for (int32 x = 0; x < GlobalMapWidth; x += SectorSize)
-		{
-			// Pick a random tile within this 50x50 block
-			// Offset by 5 to avoid edges
-			int32 RandX = x + FMath::RandRange(5, SectorSize - 5);
-			int32 RandY = y + FMath::RandRange(5, SectorSize - 5);
-			int32 GlobalIdx = RandY * GlobalMapWidth + RandX;
-
-			// Mark this tile as scary
-			if (ScaryActive.IsValidIndex(GlobalIdx))
-			{
-				ScaryActive[GlobalIdx] = true;
-			}
-			
-			UE_LOG(LogTemp, Warning, TEXT("Scary Number spawned at Global Index: %d"), GlobalIdx);
-		}
+		GridStore.Generate(GlobalMapWidth, GlobalMapHeight, GridMode, DaySeed);
 	}
-	
-	// Update the visible grid window
-	OnGridScrolled();
+
+	OnGridRebuilt();
 }
 
 /**
- * Checks if a number is prime (only 2, 3, 5, 7 in our game).
- * Used for special visual effects or mechanics.
+ * Applies map size options before a grid is built.
  */
-bool ATerminalActor::IsPrime(const int32 Number) const
+void ATerminalActor::ResolveMapDimensions()
 {
-	return (Number == 2 || Number == 3 || Number == 5 || Number == 7);
+	// Optionally snap the map to powers of two so wrapping becomes a bit mask
+	if (bPowerOfTwoMap)
+	{
+		GlobalMapWidth = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(GlobalMapWidth, 1));
+		GlobalMapHeight = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(GlobalMapHeight, 1));
+	}
 }
 
 /**
- * Checks if a screen-space tile index is currently scary.
- * Converts screen index to global index and checks ScaryActive array.
+ * Refreshes everything derived from the grid after GridStore was replaced.
  */
-bool ATerminalActor::IsIndexScary(int32 ScreenIndex) const
+void ATerminalActor::OnGridRebuilt()
 {
-	// Convert from visible grid (0-99) to global grid (0-999,999)
-	const int32 GlobalIdx = GetGlobalIndexFromScreenIndex(ScreenIndex);
+	// Rerolls and highlights for this day follow from the seed
+	GridRandomStream.Initialize((int32)HashCombine(GetTypeHash(DaySeed), 0x7E11u));
+
+	// Shared or freshly built stores carry their own budget, apply ours before the first read
+	GridStore.SetStreamingBudget((SIZE_T)FMath::Max(StreamingBudgetKB, 1) * 1024);
+
+	// Scary set changed completely
+	RefreshSensorProximity();
+
+	// Update the visible grid window
+	SyncViewport(true);
+	NotifyGridScrolled();
+
+	// Materialize the sectors around the view over the next frames, not now
+	QueueSectorWarmup();
 
-	if (ScaryActive.IsValidIndex(GlobalIdx))
+	PublishGrid();
+	PublishView();
+
+	// The grid this one replaced may have been the last user of a cached map
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
 	{
-		return ScaryActive[GlobalIdx];
+		TerminalManager->TrimGridCache();
+		TerminalManager->UpdateGridStats();
 	}
-	return false;
 }
 
 /**
- * Randomly activates one non-scary prime number as scary.
- * Used to increase difficulty/tension during gameplay.
+ * Queues the next day's grid as a low-priority worker job.
+ * The result is swapped in by StartDay, or dropped if the settings changed.
  */
-void ATerminalActor::HighlightRandomPrime()
+void ATerminalActor::PrepareNextDay()
 {
-	if (PrimeIndices.Num() == 0)
+	UTerminalJobScheduler* Scheduler = GetJobScheduler();
+
+	// Already building or built
+	if (NextDayGrid.IsValid() || (Scheduler && Scheduler->IsJobQueued(NextDayJob)))
 	{
 		return;
 	}
 
-	// Build list of prime numbers that aren't already scary
-	TArray<int32> Candidates;
-	for (int32 Idx : PrimeIndices)
+	ResolveMapDimensions();
+
+	NextDaySeed = bRandomizeDaySeed ? FMath::Rand() : DaySeed;
+	NextDayWidth = GlobalMapWidth;
+	NextDayHeight = GlobalMapHeight;
+	NextDayMode = GridMode;
+
+	const int32 Seed = NextDaySeed;
+	const int32 Width = NextDayWidth;
+	const int32 Height = NextDayHeight;
+	const ETerminalGridMode Mode = NextDayMode;
+
+	// The worker only builds a standalone store; nothing here touches the actor
+	TSharedPtr<FTerminalGridStore, ESPMode::ThreadSafe> Store = MakeShared<FTerminalGridStore, ESPMode::ThreadSafe>();
+	auto BuildGrid = [Store, Seed, Width, Height, Mode]()
 	{
-		if (ScaryActive.IsValidIndex(Idx) && !ScaryActive[Idx])
-		{
-			Candidates.Add(Idx);
-		}
-	}
+		Store->Generate(Width, Height, Mode, Seed);
+	};
 
-	// If no candidates, all primes are already scary
-	if (Candidates.Num() == 0)
+	if (!Scheduler)
 	{
+		BuildGrid();
+		NextDayGrid = Store;
+		OnNextDayPrepared.Broadcast(Seed);
 		return;
 	}
 
-	// Pick one randomly and make it scary
-	const int32 Chosen = Candidates[FMath::RandRange(0, Candidates.Num() - 1)];
-	ScaryActive[Chosen] = true;
+	// Tomorrow's map never holds up today's work; the completion runs on the game thread
+	// and is skipped if StartDay or a snapshot load gave up on the build (see ResetNextDay)
+	TWeakObjectPtr<ATerminalActor> WeakThis(this);
+	NextDayJob = Scheduler->QueueWorkerJob(this, TEXT("PrepareNextDay"), ETerminalJobPriority::Low, MoveTemp(BuildGrid),
+		[WeakThis, Store, Seed]()
+		{
+			if (ATerminalActor* Terminal = WeakThis.Get())
+			{
+				Terminal->NextDayGrid = Store;
+				Terminal->OnNextDayPrepared.Broadcast(Seed);
+			}
+		});
 }
 
-// ========================================
-// PROGRESS BAR MANAGEMENT
-// ========================================
-
 /**
- * Resets all four progress bars to 0% and notifies the UI.
- * Called when starting a new file refinement.
+ * Checks whether a prebuilt grid is finished and still matches the terminal's settings.
  */
-void ATerminalActor::ResetProgressBars()
+bool ATerminalActor::IsNextDayReady() const
 {
-	ProgressBars.Init(0.f, 4);
-
-	// Broadcast update for each bar
-	for (int32 BarIndex = 0; BarIndex < 4; ++BarIndex)
-	{
-		OnProgressUpdated(BarIndex, 0.f);
-	}
+	return NextDayGrid.IsValid()
+		&& NextDayWidth == GlobalMapWidth && NextDayHeight == GlobalMapHeight && NextDayMode == GridMode;
 }
 
 /**
- * Checks if a progress bar can accept new input.
- * A bar is unavailable if it's on cooldown OR already full.
+ * A worker that already started finishes into its own store, which is then freed.
  */
-bool ATerminalActor::IsBarAvailable(int32 BarIndex) const
+void ATerminalActor::ResetNextDay()
 {
-	// Validate array bounds
-	if (!bBarCoolingDown.IsValidIndex(BarIndex) || !ProgressBars.IsValidIndex(BarIndex))
+	if (UTerminalJobScheduler* Scheduler = GetJobScheduler())
 	{
-		return false;
+		Scheduler->CancelJob(NextDayJob);
 	}
+	NextDayJob.Reset();
+	NextDayGrid.Reset();
+}
 
-	// Check if bar is on cooldown
-	bool bIsCooling = bBarCoolingDown[BarIndex];
+// ========================================
+// SAVE / RESTORE
+// ========================================
 
-	// Check if bar is already full
-	bool bIsFull = ProgressBars[BarIndex] >= 1.0f;
+namespace TerminalSnapshot
+{
+	/** 'TRMS' - identifies a terminal snapshot */
+	static constexpr uint32 Magic = 0x54524D53;
 
-	// Bar is available only if it's NOT cooling AND NOT full
-	return !bIsCooling && !bIsFull;
+	/** Snapshot format versions. Add new entries above LatestPlusOne. */
+	enum class EVersion : int32
+	{
+		Initial = 1,
+
+		LatestPlusOne,
+		Latest = LatestPlusOne - 1
+	};
 }
 
 /**
- * Gets the cooldown progress ratio for a bar.
- * Returns 1.0 when cooldown just started, 0.0 when cooldown is done.
- * Use this to display cooldown timer UI.
+ * Writes the snapshot.
+ * 
+ * Layout (all little-endian, see FArchive):
+ * - Header: magic, version
+ * - Map: seed, width, height, mode (the grid is regenerated from these)
+ * - Day: bDayActive, scroll position, files refined, seconds into the day, difficulty level
+ * - Bars: count, then per bar its fill, cooldown duration and seconds elapsed
+ * - Grid changes (FTerminalGridStore::WriteChanges)
+ * 
+ * Times are stored relative to now, so they stay valid in a world with a different clock.
  */
-float ATerminalActor::GetBarCooldownRatio(int32 BarIndex) const
+void ATerminalActor::WriteSnapshot(TArray<uint8>& OutSnapshot) const
 {
-	if (!BarCooldownRemaining.IsValidIndex(BarIndex) || BarCooldownSeconds <= 0.f)
+	OutSnapshot.Reset();
+	FMemoryWriter Ar(OutSnapshot);
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// ========================================
+	// Header & Map
+	// ========================================
+	uint32 Magic = TerminalSnapshot::Magic;
+	int32 Version = (int32)TerminalSnapshot::EVersion::Latest;
+	int32 Seed = GridStore.GetSeed();
+	int32 Width = GridStore.GetWidth();
+	int32 Height = GridStore.GetHeight();
+	uint8 Mode = (uint8)GridStore.GetMode();
+	Ar << Magic << Version << Seed << Width << Height << Mode;
+
+	// ========================================
+	// Day State
+	// ========================================
+	uint8 bActive = bDayActive ? 1 : 0;
+	int32 SavedScrollX = ScrollX;
+	int32 SavedScrollY = ScrollY;
+	int32 SavedFiles = FilesRefinedCount;
+	float DayElapsed = bDayActive ? Now - DayStartTime : 0.f;
+	int32 SavedDifficulty = DifficultyLevel;
+	Ar << bActive << SavedScrollX << SavedScrollY << SavedFiles << DayElapsed << SavedDifficulty;
+
+	// ========================================
+	// Progress Bars & Cooldowns
+	// ========================================
+	uint8 NumBars = (uint8)ProgressBars.Num();
+	Ar << NumBars;
+	for (int32 BarIndex = 0; BarIndex < NumBars; ++BarIndex)
 	{
-		return 0.f;
+		const bool bCooling = bBarCoolingDown.IsValidIndex(BarIndex) && bBarCoolingDown[BarIndex];
+		float Fill = ProgressBars[BarIndex];
+		float CooldownDuration = bCooling ? BarCooldownDurations[BarIndex] : 0.f;
+		float CooldownElapsed = bCooling ? GetBarCooldownClock() - BarCooldownStartTimes[BarIndex] : 0.f;
+		Ar << Fill << CooldownDuration << CooldownElapsed;
 	}
-	return FMath::Clamp(BarCooldownRemaining[BarIndex] / BarCooldownSeconds, 0.f, 1.f);
+
+	// ========================================
+	// Grid Changes
+	// ========================================
+	GridStore.WriteChanges(Ar, bDeltaSnapshots);
+
+	UE_LOG(LogTerminal, Verbose, TEXT("Wrote terminal snapshot (%d bytes, %d overrides)"), OutSnapshot.Num(), GridStore.GetOverrideCount());
 }
 
 /**
- * Applies the pending chunk value to a specific progress bar.
- * Clamps bar to maximum of 1.0, triggers file completion if appropriate.
+ * Restores a snapshot.
  */
-void ATerminalActor::ApplChunkToBar(int32 BarIndex)
+bool ATerminalActor::ReadSnapshot(const TArray<uint8>& Snapshot)
 {
-	// Early exit conditions
-	if (!bDayActive || PendingChunkValue <= 0.f)
+	FMemoryReader Ar(Snapshot);
+
+	// ========================================
+	// Step 1: Validate Header
+	// ========================================
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 Seed = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+	uint8 Mode = 0;
+	Ar << Magic << Version << Seed << Width << Height << Mode;
+
+	if (Ar.IsError() || Magic != TerminalSnapshot::Magic
+		|| Version < (int32)TerminalSnapshot::EVersion::Initial || Version > (int32)TerminalSnapshot::EVersion::Latest
+		|| Width <= 0 || Height <= 0 || Mode > (uint8)ETerminalGridMode::Streamed)
 	{
-		return;
+		UE_LOG(LogTerminal, Warning, TEXT("ReadSnapshot: not a valid terminal snapshot (version %d)"), Version);
+		return false;
 	}
 
-	if (!ProgressBars.IsValidIndex(BarIndex) || ProgressBars[BarIndex] >= 1.f)
+	uint8 bActive = 0;
+	int32 SavedScrollX = 0;
+	int32 SavedScrollY = 0;
+	int32 SavedFiles = 0;
+	float DayElapsed = 0.f;
+	int32 SavedDifficulty = 0;
+	Ar << bActive << SavedScrollX << SavedScrollY << SavedFiles << DayElapsed << SavedDifficulty;
+
+	uint8 NumBars = 0;
+	Ar << NumBars;
+	TArray<float, TInlineAllocator<4>> Fills;
+	TArray<FVector2f, TInlineAllocator<4>> Cooldowns;
+	for (int32 BarIndex = 0; BarIndex < NumBars; ++BarIndex)
 	{
-		return;
+		float Fill = 0.f;
+		float CooldownDuration = 0.f;
+		float CooldownElapsed = 0.f;
+		Ar << Fill << CooldownDuration << CooldownElapsed;
+		Fills.Add(Fill);
+		Cooldowns.Add(FVector2f(CooldownDuration, CooldownElapsed));
 	}
 
-	// Apply chunk value with 1.5x multiplier
-	// (This makes the game feel more rewarding/faster-paced)
-	ProgressBars[BarIndex] = FMath::Clamp(
-		ProgressBars[BarIndex] + PendingChunkValue * 1.5f,
-		0.f,
-		1.f
-	);
-
-	// Clear the pending chunk
-	PendingChunkValue = 0.f;
-	
-	// Notify systems that chunk was consumed
-	OnChunkConsumed();
-	OnProgressUpdated(BarIndex, ProgressBars[BarIndex]);
+	if (Ar.IsError())
+	{
+		UE_LOG(LogTerminal, Warning, TEXT("ReadSnapshot: snapshot is truncated"));
+		return false;
+	}
 
-	// Check if file is complete (master progress = 100%)
-	if (GetMasterProgress() >= 1.0f)
+	// ========================================
+	// Step 2: Rebuild the Seeded Grid
+	// ========================================
+	// Built on the side so a corrupt change list leaves the live session alone
+	FTerminalGridStore RestoredGrid;
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
 	{
-		OnFileWorkComplete(); 
+		TerminalManager->AcquireGrid(Seed, Width, Height, (ETerminalGridMode)Mode, RestoredGrid);
+	}
+	else
+	{
+		RestoredGrid.Generate(Width, Height, (ETerminalGridMode)Mode, Seed);
 	}
 
-	// Check if all bars are full (triggers special state)
-	if (AllBarsFull())
+	// ========================================
+	// Step 3: Apply Eaten Tiles & Scary Changes
+	// ========================================
+	if (!RestoredGrid.ReadChanges(Ar) || Ar.IsError())
 	{
-		OnAllBarsFull();
+		UE_LOG(LogTerminal, Warning, TEXT("ReadSnapshot: grid changes are corrupt, keeping the current session"));
+		return false;
 	}
-}
 
-/**
- * Gets the proximity value to the nearest scary number.
- * Returns 0.0 when far away or no scary numbers nearby.
- * Returns 1.0 when a scary number is very close.
- * 
- * This is used to drive stress/anxiety UI elements:
- * - Screen distortion
- * - Sound effects
- * - Camera shake
- * - Warning indicators
- */
-float ATerminalActor::GetSensorProximityValue() const
-{
-	// Detection radius in tiles
-	float RealMaxDistance = 15.0f;
-	
-	float MinDistSq = FMath::Square(RealMaxDistance);
-	bool bFound = false;
+	// The whole snapshot decoded - from here on the terminal takes it over
+	DaySeed = Seed;
+	GlobalMapWidth = Width;
+	GlobalMapHeight = Height;
+	GridMode = (ETerminalGridMode)Mode;
+	ResetNextDay();
+	GridStore = MoveTemp(RestoredGrid);
 
-	// Calculate center of visible screen (accounting for scroll and sub-pixel offset)
-	float CenterX = (float)ScrollX + AccumulatorX + 4.5f; // 4.5 = center of 10x10 grid
-	float CenterY = (float)ScrollY + AccumulatorY + 4.5f;
+	// ========================================
+	// Step 4: Day, Bars & Cooldowns
+	// ========================================
+	const float Now = GetWorld()->GetTimeSeconds();
 
-	// Search a wide area around the visible screen
-	// Need to search beyond the visible grid to detect approaching threats
-	int32 SearchRadius = 16; 
+	ScrollX = GridStore.WrapX(SavedScrollX);
+	ScrollY = GridStore.WrapY(SavedScrollY);
+	AccumulatorX = 0.f;
+	AccumulatorY = 0.f;
+	FilesRefinedCount = SavedFiles;
+	bDayActive = bActive != 0;
+	DayStartTime = Now - DayElapsed;
 
-	// Scan for scary numbers in the search area
-	for (int32 y = ScrollY - SearchRadius; y <= ScrollY + SearchRadius + 10; ++y)
+	ClearBarCooldowns();
+	ProgressBars.Init(0.f, 4);
+	for (int32 BarIndex = 0; BarIndex < Fills.Num() && BarIndex < ProgressBars.Num(); ++BarIndex)
 	{
-		for (int32 x = ScrollX - SearchRadius; x <= ScrollX + SearchRadius + 10; ++x)
-		{
-			// ========================================
-			// Handle Grid Wrapping (Pac-Man Effect)
-			// ========================================
-			// The grid wraps at the edges, so we need to use modulo
-			
-			int32 WrappedX = x % GlobalMapWidth;
-			if (WrappedX < 0) WrappedX += GlobalMapWidth;
-
-			int32 WrappedY = y % GlobalMapHeight;
-			if (WrappedY < 0) WrappedY += GlobalMapHeight;
-
-			int32 GlobalIdx = WrappedY * GlobalMapWidth + WrappedX;
+		ProgressBars[BarIndex] = FMath::Clamp(Fills[BarIndex], 0.f, 1.f);
+		ResumeBarCooldown(BarIndex, Cooldowns[BarIndex].X, Cooldowns[BarIndex].Y);
+	}
 
-			// Check if this tile is scary
-			if (ScaryActive.IsValidIndex(GlobalIdx) && ScaryActive[GlobalIdx])
-			{
-				// Calculate distance using raw coordinates (not wrapped)
-				// This ensures correct distance calculation across wrap boundaries
-				float DistSq = FMath::Square(x - CenterX) + FMath::Square(y - CenterY);
-              
-				// Track the closest scary number
-				if (DistSq < MinDistSq)
-				{
-					MinDistSq = DistSq;
-					bFound = true;
-				}
-			}
-		}
+	// Resume the difficulty at the saved level (a fresh interval, not the remaining time)
+	StopDifficultySchedule();
+	DifficultyLevel = FMath::Max(SavedDifficulty, 0);
+	CurrentHighlightInterval = FMath::Max(
+		BaseHighlightInterval * FMath::Pow(HighlightIntervalScale, (float)DifficultyLevel),
+		MinHighlightInterval);
+	if (bDayActive && bUseDifficultySchedule && !bDormant)
+	{
+		ArmDifficultyTimers();
 	}
 
-	// If no scary numbers in range, return 0
-	if (!bFound)
+	// ========================================
+	// Step 5: Refresh Everything Derived
+	// ========================================
+	OnGridRebuilt();
+	PublishBars();
+	for (int32 BarIndex = 0; BarIndex < ProgressBars.Num(); ++BarIndex)
 	{
-		return 0.0f;
+		NotifyProgressUpdated(BarIndex, ProgressBars[BarIndex]);
 	}
 
-	// Convert squared distance to regular distance
-	float Distance = FMath::Sqrt(MinDistSq);
-    
-	// Convert distance to 0.0-1.0 range (1.0 = very close, 0.0 = far)
-	return FMath::Clamp(1.0f - (Distance / RealMaxDistance), 0.0f, 1.0f);
+	return true;
 }
 
 /**
- * Checks if all four progress bars have reached 100%.
+ * Snapshots now and hands the bytes to the save system's background writer.
  */
-bool ATerminalActor::AllBarsFull() const
+void ATerminalActor::SaveSnapshotAsync(const FString& SlotName, int32 UserIndex)
 {
-	for (float Bar : ProgressBars)
+	UTerminalSaveGame* SaveGame = Cast<UTerminalSaveGame>(UGameplayStatics::CreateSaveGameObject(UTerminalSaveGame::StaticClass()));
+	if (!SaveGame)
 	{
-		if (Bar < 1.f)
-		{
-			return false;
-		}
+		OnSnapshotSaved.Broadcast(SlotName, false);
+		return;
 	}
-	return true;
+
+	WriteSnapshot(SaveGame->Snapshot);
+
+	UGameplayStatics::AsyncSaveGameToSlot(SaveGame, SlotName, UserIndex,
+		FAsyncSaveGameToSlotDelegate::CreateUObject(this, &ATerminalActor::HandleSnapshotSaved));
 }
 
 /**
- * Virtual function called when all bars are full.
- * Can be overridden in Blueprint for custom behavior.
+ * Starts reading a save slot in the background.
  */
-void ATerminalActor::OnAllBarsFull()
+void ATerminalActor::LoadSnapshotAsync(const FString& SlotName, int32 UserIndex)
 {
-	UE_LOG(LogTemp, Warning, TEXT("All bars are full!"));
+	UGameplayStatics::AsyncLoadGameFromSlot(SlotName, UserIndex,
+		FAsyncLoadGameFromSlotDelegate::CreateUObject(this, &ATerminalActor::HandleSnapshotLoaded));
 }
 
 /**
- * Exits terminal mode and returns camera control to the player character.
+ * Async save finished (game thread).
  */
-void ATerminalActor::ExitTerminalMode()
+void ATerminalActor::HandleSnapshotSaved(const FString& SlotName, const int32 UserIndex, bool bSuccess)
 {
-	APlayerController* PC = GetWorld()->GetFirstPlayerController();
-
-	if (PC)
-	{
-		if (APlayerCharacter* Player = Cast<APlayerCharacter>(PC->GetPawn()))
-		{
-			Player->StandUpFromTerminal();
-		}
-	}
+	OnSnapshotSaved.Broadcast(SlotName, bSuccess);
 }
 
 /**
- * Calculates the master progress (average of all four bars).
- * When this reaches 1.0, the current file is complete.
+ * Async load finished (game thread) - apply the snapshot.
  */
-float ATerminalActor::GetMasterProgress() const
+void ATerminalActor::HandleSnapshotLoaded(const FString& SlotName, const int32 UserIndex, USaveGame* SaveGame)
 {
-	float Total = 0.0;
-	for (float BinProgress : ProgressBars)
-	{
-		Total += BinProgress;
-	}
-
-	return FMath::Clamp(Total / 4.0f, 0.0f, 1.0f);
+	const UTerminalSaveGame* TerminalSave = Cast<UTerminalSaveGame>(SaveGame);
+	const bool bSuccess = TerminalSave && ReadSnapshot(TerminalSave->Snapshot);
+	OnSnapshotLoaded.Broadcast(SlotName, bSuccess);
 }
 
 // ========================================
-// DAY / FILE MANAGEMENT
+// RECORD / REPLAY
 // ========================================
 
 /**
- * Starts a new workday.
- * Resets counters, generates fresh grid, broadcasts start event.
+ * Starts a fresh recording from the current state.
  */
-void ATerminalActor::StartDay()
+void ATerminalActor::StartRecording()
 {
-	bDayActive = true;
-	DayStartTime = GetWorld()->GetTimeSeconds();
-	
-	GenerateGrid();
-	OnDayStarted();
+	if (Replayer)
+	{
+		UE_LOG(LogTerminal, Warning, TEXT("StartRecording: %s is replaying, not recording"), *GetName());
+		return;
+	}
+
+	Recorder = MakeUnique<FTerminalRecorder>(*this);
 }
 
-/**
- * Ends the current workday.
- * Sets active flag to false, broadcasts completion event.
- */
-void ATerminalActor::EndDay()
+bool ATerminalActor::StopRecording(TArray<uint8>& OutRecording)
 {
-	bDayActive = false;
-	OnDayCompleted();
+	OutRecording.Reset();
+	if (!Recorder)
+	{
+		return false;
+	}
+
+	UE_LOG(LogTerminal, Log, TEXT("Recorded %d terminal events"), Recorder->GetRecordCount());
+	Recorder->Finish(OutRecording);
+	Recorder.Reset();
+	return true;
 }
 
-/**
+bool ATerminalActor::StopRecordingToFile(const FString& FilePath)
+{
+	TArray<uint8> Recording;
+	if (!StopRecording(Recording))
+	{
+		return false;
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Recording, *FilePath))
+	{
+		UE_LOG(LogTerminal, Warning, TEXT("Could not write terminal recording to %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Hands the terminal's timers to the recording, restores the start state and
+ * either plays everything now or steps once per tick.
+ */
+bool ATerminalActor::StartReplay(const TArray<uint8>& Recording, bool bRealTime)
+{
+	if (Replayer)
+	{
+		StopReplay();
+		if (Replayer)
+		{
+			// Called from inside the running replay
+			return false;
+		}
+	}
+	Recorder.Reset();
+
+	TUniquePtr<FTerminalReplayer> NewReplayer = MakeUnique<FTerminalReplayer>();
+	TArray<uint8> RecordingCopy = Recording;
+	if (!NewReplayer->Load(MoveTemp(RecordingCopy)))
+	{
+		return false;
+	}
+
+	// ========================================
+	// Step 1: Stop the Live Timers
+	// ========================================
+	bReplayClock = true;
+	StopDifficultySchedule();
+	for (FTimerHandle& CooldownTimer : BarCooldownTimers)
+	{
+		GetWorldTimerManager().ClearTimer(CooldownTimer);
+	}
+
+	// ========================================
+	// Step 2: Restore the Recorded Start
+	// ========================================
+	if (!NewReplayer->Begin(*this))
+	{
+		ResumeLiveTimers();
+		return false;
+	}
+	Replayer = MoveTemp(NewReplayer);
+
+	// ========================================
+	// Step 3: Play
+	// ========================================
+	if (bRealTime)
+	{
+		ReplayStartTime = GetWorld()->GetTimeSeconds();
+		ReplayTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ATerminalActor::TickReplay);
+	}
+	else
+	{
+		AdvanceReplay(TNumericLimits<double>::Max());
+	}
+	return true;
+}
+
+bool ATerminalActor::StartReplayFromFile(const FString& FilePath, bool bRealTime)
+{
+	TArray<uint8> Recording;
+	if (!FFileHelper::LoadFileToArray(Recording, *FilePath))
+	{
+		UE_LOG(LogTerminal, Warning, TEXT("Could not read terminal recording %s"), *FilePath);
+		return false;
+	}
+	return StartReplay(Recording, bRealTime);
+}
+
+/**
+ * Stops now, or right after the record being applied if called from one of its callbacks.
+ */
+void ATerminalActor::StopReplay()
+{
+	if (!Replayer)
+	{
+		return;
+	}
+
+	if (bAdvancingReplay)
+	{
+		bReplayStopRequested = true;
+		return;
+	}
+	FinishReplay();
+}
+
+/**
+ * Plays the records that are due by now, then waits for the next tick.
+ */
+void ATerminalActor::TickReplay()
+{
+	if (!Replayer)
+	{
+		return;
+	}
+
+	AdvanceReplay(GetWorld()->GetTimeSeconds() - ReplayStartTime);
+
+	if (Replayer)
+	{
+		ReplayTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ATerminalActor::TickReplay);
+	}
+}
+
+void ATerminalActor::AdvanceReplay(double PlaybackSeconds)
+{
+	bAdvancingReplay = true;
+	Replayer->Advance(*this, PlaybackSeconds);
+	bAdvancingReplay = false;
+
+	if (bReplayStopRequested || Replayer->IsFinished())
+	{
+		FinishReplay();
+	}
+}
+
+void ATerminalActor::FinishReplay()
+{
+	GetWorldTimerManager().ClearTimer(ReplayTimerHandle);
+
+	const bool bCompleted = Replayer->IsFinished() && !bReplayStopRequested;
+	LastReplayRecordCount = Replayer->GetAppliedCount();
+	Replayer.Reset();
+	bReplayStopRequested = false;
+
+	ResumeLiveTimers();
+
+	UE_LOG(LogTerminal, Log, TEXT("Replay %s after %d records"), bCompleted ? TEXT("completed") : TEXT("stopped"), LastReplayRecordCount);
+	OnReplayFinished.Broadcast(LastReplayRecordCount, bCompleted);
+}
+
+/**
+ * Cooldowns keep running from where the replay left them; ones already over end now.
+ */
+void ATerminalActor::ResumeLiveTimers()
+{
+	bReplayClock = false;
+
+	if (bDayActive && bUseDifficultySchedule && !bDormant)
+	{
+		ArmDifficultyTimers();
+	}
+
+	const float Now = GetBarCooldownClock();
+	for (int32 BarIndex = 0; BarIndex < bBarCoolingDown.Num(); ++BarIndex)
+	{
+		if (!bBarCoolingDown[BarIndex])
+		{
+			continue;
+		}
+
+		const float Elapsed = Now - BarCooldownStartTimes[BarIndex];
+		if (Elapsed >= BarCooldownDurations[BarIndex])
+		{
+			EndBarCooldown(BarIndex);
+		}
+		else
+		{
+			ResumeBarCooldown(BarIndex, BarCooldownDurations[BarIndex], Elapsed);
+		}
+	}
+}
+
+// ========================================
+// REPLICATION
+// ========================================
+
+/**
+ * Registers the replicated state.
+ * The grid is never replicated - only what a client needs to rebuild and patch it.
+ */
+void ATerminalActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ATerminalActor, ReplicatedGrid);
+	DOREPLIFETIME(ATerminalActor, TileDeltas);
+	DOREPLIFETIME(ATerminalActor, ReplicatedView);
+	DOREPLIFETIME(ATerminalActor, ReplicatedBars);
+	DOREPLIFETIME(ATerminalActor, bDayActive);
+	DOREPLIFETIME(ATerminalActor, FilesRefinedCount);
+}
+
+/**
+ * Only a server in a networked game publishes; standalone play skips the bookkeeping.
+ */
+bool ATerminalActor::IsPublishingState() const
+{
+	return HasAuthority() && GetNetMode() != NM_Standalone;
+}
+
+/**
+ * Publishes the seed of the current grid and lists every tile that already differs
+ * from it (usually none - a fresh grid has no changes).
+ */
+void ATerminalActor::PublishGrid()
+{
+	if (!IsPublishingState())
+	{
+		return;
+	}
+
+	ReplicatedGrid.Seed = GridStore.GetSeed();
+	ReplicatedGrid.Width = GridStore.GetWidth();
+	ReplicatedGrid.Height = GridStore.GetHeight();
+	ReplicatedGrid.Mode = GridStore.GetMode();
+
+	TileDeltas.Clear();
+	if (!GridStore.IsPristine())
+	{
+		// e.g. a restored snapshot
+		TArray<int32> ChangedTiles;
+		GridStore.GatherChangedTiles(ChangedTiles);
+		for (const int32 Index : ChangedTiles)
+		{
+			PublishTile(Index);
+		}
+	}
+}
+
+/**
+ * Publishes a tile's current number and scary state.
+ */
+void ATerminalActor::PublishTile(int32 GlobalIndex)
+{
+	if (IsPublishingState() && GridStore.IsValidIndex(GlobalIndex))
+	{
+		TileDeltas.SetTile(GlobalIndex, (uint8)GridStore.GetNumber(GlobalIndex), GridStore.IsScary(GlobalIndex));
+	}
+}
+
+/**
+ * Publishes the scroll position with the sub-tile part quantized to a byte.
+ */
+void ATerminalActor::PublishView()
+{
+	if (!IsPublishingState())
+	{
+		return;
+	}
+
+	ReplicatedView.ScrollX = ScrollX;
+	ReplicatedView.ScrollY = ScrollY;
+	ReplicatedView.SubTileX = (int8)FMath::Clamp(FMath::RoundToInt(AccumulatorX * 127.f), -127, 127);
+	ReplicatedView.SubTileY = (int8)FMath::Clamp(FMath::RoundToInt(AccumulatorY * 127.f), -127, 127);
+}
+
+/**
+ * Publishes bar fills and the remaining time of running cooldowns.
+ */
+void ATerminalActor::PublishBars()
+{
+	if (!IsPublishingState())
+	{
+		return;
+	}
+
+	for (int32 BarIndex = 0; BarIndex < FTerminalReplicatedBars::NumBars; ++BarIndex)
+	{
+		const float Fill = ProgressBars.IsValidIndex(BarIndex) ? ProgressBars[BarIndex] : 0.f;
+		ReplicatedBars.Fill[BarIndex] = (uint16)FMath::RoundToInt(FMath::Clamp(Fill, 0.f, 1.f) * MAX_uint16);
+
+		// Round up so a cooldown that is still running never reads as finished
+		const float Remaining = GetBarCooldownRemaining(BarIndex);
+		ReplicatedBars.CooldownRemaining[BarIndex] = (uint16)FMath::Clamp(FMath::CeilToInt(Remaining * 100.f), 0, (int32)MAX_uint16);
+	}
+}
+
+/**
+ * Client: new seed or map settings - rebuild the grid locally, then patch in
+ * every tile change received so far (late joiners get the full list).
+ */
+void ATerminalActor::OnRep_ReplicatedGrid()
+{
+	if (ReplicatedGrid.Width <= 0 || ReplicatedGrid.Height <= 0)
+	{
+		return;
+	}
+
+	DaySeed = ReplicatedGrid.Seed;
+	GlobalMapWidth = ReplicatedGrid.Width;
+	GlobalMapHeight = ReplicatedGrid.Height;
+	GridMode = ReplicatedGrid.Mode;
+
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+	{
+		TerminalManager->AcquireGrid(DaySeed, GlobalMapWidth, GlobalMapHeight, GridMode, GridStore);
+	}
+	else
+	{
+		GridStore.Generate(GlobalMapWidth, GlobalMapHeight, GridMode, DaySeed);
+	}
+
+	PendingReplicatedTiles.Reset();
+	for (const FTerminalTileDelta& Tile : TileDeltas.Items)
+	{
+		ApplyReplicatedTile(Tile);
+	}
+	PendingReplicatedTiles.Reset();
+
+	ScrollX = GridStore.WrapX(ReplicatedView.ScrollX);
+	ScrollY = GridStore.WrapY(ReplicatedView.ScrollY);
+	OnGridRebuilt();
+}
+
+/**
+ * Client: applies a tile change to the local grid.
+ * Changes that arrive before the grid for their seed are skipped; OnRep_ReplicatedGrid
+ * reapplies the whole list once the grid is built.
+ */
+void ATerminalActor::ApplyReplicatedTile(const FTerminalTileDelta& Tile)
+{
+	if (HasAuthority() || GridStore.GetSeed() != ReplicatedGrid.Seed
+		|| GridStore.GetWidth() != ReplicatedGrid.Width || GridStore.GetHeight() != ReplicatedGrid.Height
+		|| !GridStore.IsValidIndex(Tile.Index))
+	{
+		return;
+	}
+
+	GridStore.SetNumber(Tile.Index, Tile.Number);
+	GridStore.SetScary(Tile.Index, Tile.bScary);
+	PendingReplicatedTiles.Add(Tile.Index);
+}
+
+/**
+ * Client: one viewport delta and one sensor refresh per received packet.
+ */
+void ATerminalActor::FlushReplicatedTiles()
+{
+	if (PendingReplicatedTiles.Num() == 0)
+	{
+		return;
+	}
+
+	ViewportDelta.ShiftX = 0;
+	ViewportDelta.ShiftY = 0;
+	ViewportDelta.bFullRefresh = false;
+
+	TArray<int32, TInlineAllocator<16>> ChangedSlots;
+	for (const int32 GlobalIndex : PendingReplicatedTiles)
+	{
+		const int32 Slot = RefreshViewportTile(GlobalIndex);
+		if (Slot != INDEX_NONE)
+		{
+			ChangedSlots.AddUnique(Slot);
+		}
+	}
+	PendingReplicatedTiles.Reset();
+	GridTexels.Flush();
+
+	RefreshSensorProximity();
+
+	if (ChangedSlots.Num() > 0)
+	{
+		RebuildViewportPrimes();
+		ViewportDelta.ChangedSlots = ChangedSlots;
+		NotifyViewportDelta();
+	}
+}
+
+/**
+ * Client: the refiner scrolled.
+ */
+void ATerminalActor::OnRep_ReplicatedView()
+{
+	if (GridStore.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 NewScrollX = GridStore.WrapX(ReplicatedView.ScrollX);
+	const int32 NewScrollY = GridStore.WrapY(ReplicatedView.ScrollY);
+	AccumulatorX = ReplicatedView.SubTileX / 127.f;
+	AccumulatorY = ReplicatedView.SubTileY / 127.f;
+
+	RefreshSensorProximity();
+	UpdateGridTextureWindow();
+
+	if (NewScrollX != ScrollX || NewScrollY != ScrollY)
+	{
+		ScrollX = NewScrollX;
+		ScrollY = NewScrollY;
+		SyncViewport(false);
+		NotifyGridScrolled();
+	}
+}
+
+/**
+ * Client: bars or cooldowns changed.
+ * Cooldowns are restarted locally from the remaining time, so they count down without further traffic.
+ */
+void ATerminalActor::OnRep_ReplicatedBars()
+{
+	for (int32 BarIndex = 0; BarIndex < FTerminalReplicatedBars::NumBars && BarIndex < ProgressBars.Num(); ++BarIndex)
+	{
+		const float Fill = ReplicatedBars.Fill[BarIndex] / (float)MAX_uint16;
+		if (Fill != ProgressBars[BarIndex])
+		{
+			ProgressBars[BarIndex] = Fill;
+			NotifyProgressUpdated(BarIndex, Fill);
+		}
+
+		const float Remaining = ReplicatedBars.CooldownRemaining[BarIndex] / 100.f;
+		const bool bCooling = bBarCoolingDown.IsValidIndex(BarIndex) && bBarCoolingDown[BarIndex];
+		if (Remaining > 0.f)
+		{
+			// Keep the local duration when possible so the ratio matches the server's
+			const float Duration = FMath::Max(BarCooldownSeconds, Remaining);
+			ResumeBarCooldown(BarIndex, Duration, Duration - Remaining);
+		}
+		else if (bCooling)
+		{
+			EndBarCooldown(BarIndex);
+		}
+	}
+}
+
+/**
+ * Checks if a number is prime (only 2, 3, 5, 7 in our game).
+ * Used for special visual effects or mechanics.
+ */
+bool ATerminalActor::IsPrime(const int32 Number) const
+{
+	return (Number == 2 || Number == 3 || Number == 5 || Number == 7);
+}
+
+/**
+ * Checks if a screen-space tile index is currently scary.
+ * Converts screen index to global index and checks the packed scary mask.
+ */
+bool ATerminalActor::IsIndexScary(int32 ScreenIndex) const
+{
+	// Convert from visible grid (0-99) to global grid (0-999,999)
+	const int32 GlobalIdx = GetGlobalIndexFromScreenIndex(ScreenIndex);
+
+	return GridStore.IsScary(GlobalIdx);
+}
+
+/**
+ * Reads the scary bit straight from the grid store (bounds-checked there).
+ */
+bool ATerminalActor::IsGlobalIndexScary(int32 GlobalIndex) const
+{
+	return GridStore.IsScary(GlobalIndex);
+}
+
+/**
+ * Randomly activates one non-scary prime number as scary.
+ * Used to increase difficulty/tension during gameplay.
+ */
+void ATerminalActor::HighlightRandomPrime()
+{
+	int32 Chosen = INDEX_NONE;
+
+	if (PrimeHighlightScope == ETerminalPrimeScope::Viewport)
+	{
+		// Candidate set is maintained as tiles enter/leave the view and flip scary,
+		// so picking is O(1) with no per-call allocation
+		if (PrimeCandidateSlots.Num() == 0)
+		{
+			// All visible primes are already scary (or none are visible)
+			return;
+		}
+
+		const int32 Slot = PrimeCandidateSlots[GridRandomStream.RandRange(0, PrimeCandidateSlots.Num() - 1)];
+		Chosen = ViewportSlotGlobal[Slot];
+	}
+	else
+	{
+		Chosen = PickRandomMapPrime();
+	}
+
+	if (!GridStore.IsValidIndex(Chosen))
+	{
+		return;
+	}
+
+	// Make it scary
+	GridStore.SetScary(Chosen, true);
+	PublishTile(Chosen);
+	RefreshSensorProximity();
+
+	// Let the widget redraw just the newly highlighted tile
+	const int32 Slot = RefreshViewportTile(Chosen);
+	GridTexels.Flush();
+	if (Slot != INDEX_NONE)
+	{
+		ViewportDelta.ShiftX = 0;
+		ViewportDelta.ShiftY = 0;
+		ViewportDelta.bFullRefresh = false;
+		ViewportDelta.ChangedSlots.Reset();
+		ViewportDelta.ChangedSlots.Add(Slot);
+		NotifyViewportDelta();
+	}
+}
+
+// ========================================
+// PROGRESS BAR MANAGEMENT
+// ========================================
+
+/**
+ * Resets all four progress bars to 0% and notifies the UI.
+ * Called when starting a new file refinement.
+ */
+void ATerminalActor::ResetProgressBars()
+{
+	ProgressBars.Init(0.f, 4);
+	ClearBarCooldowns();
+	PublishBars();
+
+	// Broadcast update for each bar
+	for (int32 BarIndex = 0; BarIndex < 4; ++BarIndex)
+	{
+		NotifyProgressUpdated(BarIndex, 0.f);
+	}
+}
+
+/**
+ * Checks if a progress bar can accept new input.
+ * A bar is unavailable if it's on cooldown OR already full.
+ */
+bool ATerminalActor::IsBarAvailable(int32 BarIndex) const
+{
+	// Validate array bounds
+	if (!bBarCoolingDown.IsValidIndex(BarIndex) || !ProgressBars.IsValidIndex(BarIndex))
+	{
+		return false;
+	}
+
+	// Check if bar is on cooldown
+	bool bIsCooling = bBarCoolingDown[BarIndex];
+
+	// Check if bar is already full
+	bool bIsFull = ProgressBars[BarIndex] >= 1.0f;
+
+	// Bar is available only if it's NOT cooling AND NOT full
+	return !bIsCooling && !bIsFull;
+}
+
+/**
+ * Gets the cooldown progress ratio for a bar.
+ * Returns 1.0 when cooldown just started, 0.0 when cooldown is done.
+ * Use this to display cooldown timer UI.
+ */
+float ATerminalActor::GetBarCooldownRatio(int32 BarIndex) const
+{
+	if (!BarCooldownDurations.IsValidIndex(BarIndex) || BarCooldownDurations[BarIndex] <= 0.f)
+	{
+		return 0.f;
+	}
+	return FMath::Clamp(GetBarCooldownRemaining(BarIndex) / BarCooldownDurations[BarIndex], 0.f, 1.f);
+}
+
+/**
+ * Gets the seconds left on a bar's cooldown from its start timestamp.
+ */
+float ATerminalActor::GetBarCooldownRemaining(int32 BarIndex) const
+{
+	if (!bBarCoolingDown.IsValidIndex(BarIndex) || !bBarCoolingDown[BarIndex])
+	{
+		return 0.f;
+	}
+
+	const float Elapsed = GetBarCooldownClock() - BarCooldownStartTimes[BarIndex];
+	return FMath::Max(BarCooldownDurations[BarIndex] - Elapsed, 0.f);
+}
+
+/**
+ * Puts a bar on cooldown.
+ * Each bar owns a one-shot timer, so an idle terminal does no per-frame work
+ * no matter how many bars are cooling.
+ */
+void ATerminalActor::StartBarCooldown(int32 BarIndex)
+{
+	ResumeBarCooldown(BarIndex, BarCooldownSeconds, 0.f);
+}
+
+/**
+ * Arms a bar cooldown that may already be partly over (restored from a snapshot).
+ * Keeps the original duration so GetBarCooldownRatio continues where it left off.
+ */
+void ATerminalActor::ResumeBarCooldown(int32 BarIndex, float Duration, float Elapsed)
+{
+	const float Remaining = Duration - Elapsed;
+	if (!bBarCoolingDown.IsValidIndex(BarIndex) || Remaining <= 0.f)
+	{
+		return;
+	}
+
+	bBarCoolingDown[BarIndex] = true;
+	BarCooldownDurations[BarIndex] = Duration;
+	BarCooldownRemaining[BarIndex] = Remaining;
+	BarCooldownStartTimes[BarIndex] = GetBarCooldownClock() - Elapsed;
+
+	// SetTimer on an active handle restarts it (a replay ends the cooldown from the recording instead)
+	if (!bReplayClock)
+	{
+		FTimerManager& TimerManager = GetWorldTimerManager();
+		TimerManager.SetTimer(
+			BarCooldownTimers[BarIndex],
+			FTimerDelegate::CreateUObject(this, &ATerminalActor::HandleBarCooldownTimer, BarIndex),
+			Remaining,
+			false);
+
+		// Armed while asleep (e.g. a snapshot load) - wait for the wake like the rest
+		if (bBarCooldownsPaused)
+		{
+			TimerManager.PauseTimer(BarCooldownTimers[BarIndex]);
+		}
+	}
+
+	OnBarCooldownStarted(BarIndex, Remaining);
+	PublishBars();
+}
+
+/**
+ * Timer callback - the bar can accept input again.
+ */
+void ATerminalActor::EndBarCooldown(int32 BarIndex)
+{
+	if (!bBarCoolingDown.IsValidIndex(BarIndex) || !bBarCoolingDown[BarIndex])
+	{
+		return;
+	}
+
+	GetWorldTimerManager().ClearTimer(BarCooldownTimers[BarIndex]);
+	bBarCoolingDown[BarIndex] = false;
+	BarCooldownDurations[BarIndex] = 0.f;
+	BarCooldownRemaining[BarIndex] = 0.f;
+	PublishBars();
+
+	OnBarCooldownEnded(BarIndex);
+}
+
+/**
+ * Timer callback - the only path a recording needs to capture, since every
+ * other EndBarCooldown call follows from a recorded call.
+ */
+void ATerminalActor::HandleBarCooldownTimer(int32 BarIndex)
+{
+	if (Recorder)
+	{
+		Recorder->RecordCooldownTimer(BarIndex);
+	}
+	EndBarCooldown(BarIndex);
+}
+
+/**
+ * Holds every cooldown timer where it is; the clock stops at the pause time.
+ */
+void ATerminalActor::PauseBarCooldowns()
+{
+	if (bBarCooldownsPaused)
+	{
+		return;
+	}
+
+	BarCooldownPauseTime = GetWorld()->GetTimeSeconds();
+	bBarCooldownsPaused = true;
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	for (FTimerHandle& Timer : BarCooldownTimers)
+	{
+		TimerManager.PauseTimer(Timer);
+	}
+}
+
+/**
+ * Shifts the start times by the time spent paused, so remaining time and ratio
+ * continue from the pause, then lets the timers run again.
+ */
+void ATerminalActor::UnpauseBarCooldowns()
+{
+	if (!bBarCooldownsPaused)
+	{
+		return;
+	}
+
+	const float PausedFor = GetWorld()->GetTimeSeconds() - BarCooldownPauseTime;
+	bBarCooldownsPaused = false;
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	for (int32 BarIndex = 0; BarIndex < bBarCoolingDown.Num(); ++BarIndex)
+	{
+		if (bBarCoolingDown[BarIndex])
+		{
+			BarCooldownStartTimes[BarIndex] += PausedFor;
+		}
+		TimerManager.UnPauseTimer(BarCooldownTimers[BarIndex]);
+	}
+}
+
+/**
+ * World time while running, the pause time while paused.
+ */
+float ATerminalActor::GetBarCooldownClock() const
+{
+	return bBarCooldownsPaused ? BarCooldownPauseTime : GetWorld()->GetTimeSeconds();
+}
+
+/**
+ * Cancels all running cooldowns (new file or end of day).
+ */
+void ATerminalActor::ClearBarCooldowns()
+{
+	for (int32 BarIndex = 0; BarIndex < bBarCoolingDown.Num(); ++BarIndex)
+	{
+		EndBarCooldown(BarIndex);
+	}
+}
+
+/**
+ * Applies the pending chunk value to a specific progress bar.
+ * Clamps bar to maximum of 1.0, triggers file completion if appropriate.
+ */
+void ATerminalActor::ApplChunkToBar(int32 BarIndex)
+{
+	if (Recorder)
+	{
+		Recorder->RecordApplyChunk(BarIndex);
+	}
+
+	// Early exit conditions
+	if (!bDayActive || PendingChunkValue <= 0.f)
+	{
+		return;
+	}
+
+	// Full or cooling bars reject input (the chunk stays pending for another bar)
+	if (!IsBarAvailable(BarIndex))
+	{
+		return;
+	}
+
+	// Apply chunk value with 1.5x multiplier
+	// (This makes the game feel more rewarding/faster-paced)
+	ProgressBars[BarIndex] = FMath::Clamp(
+		ProgressBars[BarIndex] + PendingChunkValue * 1.5f,
+		0.f,
+		1.f
+	);
+
+	// Clear the pending chunk
+	PendingChunkValue = 0.f;
+	
+	// Notify systems that chunk was consumed
+	NotifyChunkConsumed();
+	NotifyProgressUpdated(BarIndex, ProgressBars[BarIndex]);
+
+	// A bar that just filled rests before it can be used again
+	// (started before the completion checks so a file reset clears it again)
+	if (ProgressBars[BarIndex] >= 1.f)
+	{
+		StartBarCooldown(BarIndex);
+	}
+	PublishBars();
+
+	// Check if file is complete (master progress = 100%)
+	if (GetMasterProgress() >= 1.0f)
+	{
+		OnFileWorkComplete(); 
+	}
+
+	// Check if all bars are full (triggers special state)
+	if (AllBarsFull())
+	{
+		OnAllBarsFull();
+	}
+}
+
+/**
+ * Recomputes the proximity value to the nearest scary number.
+ * 0.0 when far away or no scary numbers nearby, 1.0 when a scary number is very close.
+ * 
+ * This is used to drive stress/anxiety UI elements:
+ * - Screen distortion
+ * - Sound effects
+ * - Camera shake
+ * - Warning indicators
+ * 
+ * Listeners are only notified when the value crosses a threshold, so per-frame
+ * jitter while scrolling doesn't spam the UI.
+ */
+void ATerminalActor::RefreshSensorProximity()
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalSensorQuery, "Terminal.SensorQuery");
+	INC_DWORD_STAT(STAT_TerminalSensorQueries);
+
+	// Detection radius in tiles
+	const float RealMaxDistance = MaxSensorDistance;
+
+	// Nothing close enough (or nothing scary at all) reads as 0
+	const float Distance = GetDistanceToNearestScary();
+	CachedSensorProximity = (Distance >= RealMaxDistance || RealMaxDistance <= 0.f)
+		? 0.0f
+		// Convert distance to 0.0-1.0 range (1.0 = very close, 0.0 = far)
+		: FMath::Clamp(1.0f - (Distance / RealMaxDistance), 0.0f, 1.0f);
+
+	// Count how many thresholds we are at or above
+	int32 NewLevel = 0;
+	for (const float Threshold : SensorThresholds)
+	{
+		if (CachedSensorProximity >= Threshold)
+		{
+			++NewLevel;
+		}
+	}
+
+	if (NewLevel != SensorThresholdLevel)
+	{
+		SensorThresholdLevel = NewLevel;
+		OnSensorProximityChanged.Broadcast(CachedSensorProximity, SensorThresholdLevel);
+	}
+}
+
+/**
+ * Finds the distance to the nearest scary number from the center of the screen.
+ * Returns MaxSensorDistance if nothing is within range.
+ *
+ * Uses the grid store's sector-bucketed scary index (or the resident sectors of
+ * a Streamed grid), so only the few sectors overlapping the sensor radius are
+ * visited instead of scanning every tile. Once late-day highlights crowd those
+ * sectors the store switches to a word-wise scan of the scary mask instead.
+ */
+float ATerminalActor::GetDistanceToNearestScary() const
+{
+	// Nothing to detect (also covers the grid not being generated yet)
+	if (GridStore.GetScaryCount() == 0)
+	{
+		return MaxSensorDistance;
+	}
+
+	// Calculate center of visible screen (accounting for scroll and sub-pixel offset)
+	// For the default 10x10 grid the center is 4.5 tiles in
+	const float CenterX = (float)ScrollX + AccumulatorX + (GridWidth - 1) * 0.5f;
+	const float CenterY = (float)ScrollY + AccumulatorY + (GridHeight - 1) * 0.5f;
+
+	// Search the index for the closest scary tile (wrap-around aware)
+	float MinDistSq = 0.f;
+	if (!GridStore.FindNearestScary(CenterX, CenterY, MaxSensorDistance, MinDistSq))
+	{
+		return MaxSensorDistance;
+	}
+
+	// Convert squared distance to regular distance
+	return FMath::Sqrt(MinDistSq);
+}
+
+/**
+ * Picks a random non-scary prime anywhere on the map.
+ *
+ * Roughly 4 in 9 tiles are primes and scary tiles are sparse, so rejection
+ * sampling finds one in ~2-3 tries on average. This is O(1) expected and
+ * needs no map-sized candidate index (which would defeat Procedural mode).
+ */
+int32 ATerminalActor::PickRandomMapPrime()
+{
+	if (GridStore.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	constexpr int32 MaxAttempts = 64;
+	for (int32 Attempt = 0; Attempt < MaxAttempts; ++Attempt)
+	{
+		const int32 Idx = GridRandomStream.RandRange(0, GridStore.Num() - 1);
+		if (IsPrime(GridStore.GetNumber(Idx)) && !GridStore.IsScary(Idx))
+		{
+			return Idx;
+		}
+	}
+	return INDEX_NONE;
+}
+
+// ========================================
+// DORMANCY
+// ========================================
+
+/**
+ * Puts the terminal to sleep.
+ * Timers stop right away; buffers are released after DormantReleaseDelay so
+ * a player glancing away and sitting back down doesn't rebuild anything.
+ */
+void ATerminalActor::EnterDormant()
+{
+	if (bDormant)
+	{
+		return;
+	}
+
+	bDormant = true;
+
+	// Keep the difficulty where it was - paused timers resume with their remaining time
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	TimerManager.PauseTimer(HighlightTimerHandle);
+	TimerManager.PauseTimer(StressTimerHandle);
+
+	// Cooldowns wait too, so standing up doesn't skip them (clients follow the server's)
+	if (HasAuthority())
+	{
+		PauseBarCooldowns();
+	}
+
+	// Rebuilding the viewport is one SyncViewport, so drop it right away
+	ReleaseViewportCaches();
+
+	// Nothing to warm up while nobody looks; a grid with eaten tiles is kept, so tidy it up
+	if (UTerminalJobScheduler* Scheduler = GetJobScheduler())
+	{
+		Scheduler->CancelJob(WarmupJob);
+		if (!GridStore.IsPristine() && !Scheduler->IsJobQueued(CompactJob))
+		{
+			TWeakObjectPtr<ATerminalActor> WeakThis(this);
+			CompactJob = Scheduler->QueueJob(this, TEXT("CompactGridChanges"), ETerminalJobPriority::Low,
+				[WeakThis](double /*DeadlineSeconds*/)
+				{
+					ATerminalActor* Terminal = WeakThis.Get();
+					if (Terminal && Terminal->bDormant)
+					{
+						Terminal->GridStore.CompactChanges();
+					}
+					return true;
+				});
+		}
+	}
+
+	if (DormantReleaseDelay > 0.f)
+	{
+		GetWorldTimerManager().SetTimer(DormantReleaseTimerHandle, this, &ATerminalActor::ReleaseDormantBuffers, DormantReleaseDelay, false);
+	}
+	else
+	{
+		ReleaseDormantBuffers();
+	}
+}
+
+/**
+ * Wakes the terminal back up.
+ */
+void ATerminalActor::WakeFromDormant()
+{
+	if (!bDormant)
+	{
+		return;
+	}
+
+	bDormant = false;
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	TimerManager.ClearTimer(DormantReleaseTimerHandle);
+
+	if (UTerminalJobScheduler* Scheduler = GetJobScheduler())
+	{
+		Scheduler->CancelJob(CompactJob);
+	}
+
+	if (GridStore.Num() == 0 && !HasAuthority())
+	{
+		// Tile changes that arrived while the grid was released were skipped - rebuild
+		// through the replication path so the full change list is applied again
+		OnRep_ReplicatedGrid();
+	}
+	else if (GridStore.Num() == 0)
+	{
+		// Grid was released untouched - the same seed gives back the same map
+		GenerateGrid();
+	}
+	else if (!bViewportValid)
+	{
+		SyncViewport(true);
+		NotifyGridScrolled();
+		QueueSectorWarmup();
+	}
+
+	// Resume the difficulty where it was when the terminal fell asleep
+	// (a day started while asleep has no timers yet)
+	if (TimerManager.TimerExists(HighlightTimerHandle) || TimerManager.TimerExists(StressTimerHandle))
+	{
+		TimerManager.UnPauseTimer(HighlightTimerHandle);
+		TimerManager.UnPauseTimer(StressTimerHandle);
+	}
+	else if (bDayActive && bUseDifficultySchedule)
+	{
+		ArmDifficultyTimers();
+	}
+
+	UnpauseBarCooldowns();
+}
+
+/**
+ * Frees the grid of a sleeping terminal.
+ * Clients may free it too: WakeFromDormant rebuilds it from the replicated seed and tile changes.
+ */
+void ATerminalActor::ReleaseDormantBuffers()
+{
+	if (!bDormant)
+	{
+		return;
+	}
+
+	// An untouched grid can be re-acquired; one with eaten tiles must be kept
+	if (GridStore.IsPristine())
+	{
+		GridStore.Reset();
+		if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+		{
+			TerminalManager->TrimGridCache();
+			TerminalManager->UpdateGridStats();
+		}
+	}
+}
+
+/**
+ * Frees the viewport ring buffer and its prime lists.
+ */
+void ATerminalActor::ReleaseViewportCaches()
+{
+	GridNumbers.Empty();
+	HighlightedPrimes.Empty();
+	PrimeIndices.Empty();
+	ViewportSlotGlobal.Empty();
+	PrimeCandidateSlots.Empty();
+	PrimeCandidatePos.Empty();
+	ViewportDelta.ChangedSlots.Empty();
+	bViewportValid = false;
+	GridTexels.ReleaseTexels();
+
+	// Streamed sectors are rebuilt from the seed on the next SyncViewport
+	GridStore.ReleaseSectors();
+}
+
+/**
+ * Applies a redraw interval to every widget component on the terminal
+ * (the CRT screen widget is added in Blueprint).
+ */
+void ATerminalActor::SetScreenRedrawTime(float RedrawTime)
+{
+	TInlineComponentArray<UWidgetComponent*> ScreenWidgets(this);
+	for (UWidgetComponent* ScreenWidget : ScreenWidgets)
+	{
+		ScreenWidget->SetRedrawTime(RedrawTime);
+	}
+}
+
+// ========================================
+// SCHEDULED JOBS
+// ========================================
+
+/**
+ * Looks up the job scheduler of the terminal's world.
+ */
+UTerminalJobScheduler* ATerminalActor::GetJobScheduler() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UTerminalJobScheduler>() : nullptr;
+}
+
+/**
+ * Prefetches one sector per step, ring by ring around the view, until the frame's
+ * deadline. Sectors the view scrolls into later are then already resident.
+ */
+void ATerminalActor::QueueSectorWarmup()
+{
+	UTerminalJobScheduler* Scheduler = GetJobScheduler();
+	if (!Scheduler)
+	{
+		return;
+	}
+
+	Scheduler->CancelJob(WarmupJob);
+
+	if (bDormant || WarmupSectorRadius <= 0 || GridStore.GetMode() != ETerminalGridMode::Streamed || GridStore.Num() == 0)
+	{
+		return;
+	}
+
+	// Whole sectors from the one holding the view origin, plus the rings around them
+	constexpr int32 SectorSize = FTerminalGridStore::SectorSize;
+	const int32 OriginSectorX = FMath::FloorToInt((float)ScrollX / SectorSize);
+	const int32 OriginSectorY = FMath::FloorToInt((float)ScrollY / SectorSize);
+	const int32 ViewSectorsX = FMath::DivideAndRoundUp(ScrollX + GridWidth - OriginSectorX * SectorSize, SectorSize);
+	const int32 ViewSectorsY = FMath::DivideAndRoundUp(ScrollY + GridHeight - OriginSectorY * SectorSize, SectorSize);
+	const int32 MaxRing = WarmupSectorRadius;
+
+	TWeakObjectPtr<ATerminalActor> WeakThis(this);
+	WarmupJob = Scheduler->QueueJob(this, TEXT("WarmSectors"), ETerminalJobPriority::Normal,
+		[WeakThis, OriginSectorX, OriginSectorY, ViewSectorsX, ViewSectorsY, MaxRing, Ring = 1, Step = 0](double DeadlineSeconds) mutable
+		{
+			ATerminalActor* Terminal = WeakThis.Get();
+			if (!Terminal)
+			{
+				return true;
+			}
+
+			while (Ring <= MaxRing)
+			{
+				// Ring N is the border of the view's sectors grown by N on every side
+				const int32 RingWidth = ViewSectorsX + 2 * Ring;
+				const int32 RingHeight = ViewSectorsY + 2 * Ring;
+				const int32 RingCells = 2 * RingWidth + 2 * (RingHeight - 2);
+				if (Step >= RingCells)
+				{
+					++Ring;
+					Step = 0;
+					continue;
+				}
+
+				// Top row, bottom row, then the left and right columns between them
+				int32 LocalX = 0;
+				int32 LocalY = 0;
+				if (Step < RingWidth)
+				{
+					LocalX = Step;
+				}
+				else if (Step < 2 * RingWidth)
+				{
+					LocalX = Step - RingWidth;
+					LocalY = RingHeight - 1;
+				}
+				else
+				{
+					const int32 Side = Step - 2 * RingWidth;
+					LocalX = (Side & 1) ? RingWidth - 1 : 0;
+					LocalY = 1 + Side / 2;
+				}
+				++Step;
+
+				const int32 TileX = (OriginSectorX - Ring + LocalX) * SectorSize;
+				const int32 TileY = (OriginSectorY - Ring + LocalY) * SectorSize;
+				Terminal->GridStore.PrefetchSectors(TileX, TileY, TileX + SectorSize - 1, TileY + SectorSize - 1);
+
+				if (FPlatformTime::Seconds() >= DeadlineSeconds)
+				{
+					break;
+				}
+			}
+			return Ring > MaxRing;
+		});
+}
+
+// ========================================
+// PLAYER LIFECYCLE
+// ========================================
+
+/**
+ * The player sat down at this terminal.
+ */
+void ATerminalActor::NotifyPlayerInteract()
+{
+	// Wake synchronously so the first seated frame already has a full viewport
+	if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+	{
+		TerminalManager->SetActiveTerminal(this);
+	}
+	else
+	{
+		WakeFromDormant();
+	}
+
+	SetScreenRedrawTime(ActiveScreenRedrawTime);
+	OnPlayerInteract();
+}
+
+/**
+ * The player stood up from this terminal.
+ */
+void ATerminalActor::NotifyPlayerExit()
+{
+	OnPlayerExit();
+
+	UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>();
+	if (TerminalManager && TerminalManager->GetActiveTerminal() == this)
+	{
+		TerminalManager->SetActiveTerminal(nullptr);
+	}
+	else
+	{
+		EnterDormant();
+	}
+
+	SetScreenRedrawTime(IdleScreenRedrawTime);
+}
+
+// ========================================
+// DIFFICULTY SCHEDULE
+// ========================================
+
+/**
+ * Starts the highlight and stress timers from difficulty level 0.
+ * Timers only run while a day is active, so idle terminals cost nothing.
+ */
+void ATerminalActor::StartDifficultySchedule()
+{
+	StopDifficultySchedule();
+
+	DifficultyLevel = 0;
+	CurrentHighlightInterval = FMath::Max(BaseHighlightInterval, MinHighlightInterval);
+
+	// A sleeping terminal arms its timers when it wakes up
+	if (!bDormant)
+	{
+		ArmDifficultyTimers();
+	}
+}
+
+/**
+ * Starts the highlight and stress timers at the current difficulty.
+ */
+void ATerminalActor::ArmDifficultyTimers()
+{
+	// Highlights are picked by the server and replicate as tile changes;
+	// during a replay the recording fires them
+	if (!HasAuthority() || bReplayClock)
+	{
+		return;
+	}
+
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	if (CurrentHighlightInterval > 0.f)
+	{
+		TimerManager.SetTimer(HighlightTimerHandle, this, &ATerminalActor::HandleHighlightTimer, CurrentHighlightInterval, true);
+	}
+	if (StressInterval > 0.f)
+	{
+		TimerManager.SetTimer(StressTimerHandle, this, &ATerminalActor::HandleStressTimer, StressInterval, true);
+	}
+}
+
+/**
+ * Stops both difficulty timers.
+ */
+void ATerminalActor::StopDifficultySchedule()
+{
+	FTimerManager& TimerManager = GetWorldTimerManager();
+	TimerManager.ClearTimer(HighlightTimerHandle);
+	TimerManager.ClearTimer(StressTimerHandle);
+}
+
+/**
+ * Highlight timer - turns one prime scary.
+ */
+void ATerminalActor::HandleHighlightTimer()
+{
+	if (Recorder)
+	{
+		Recorder->RecordHighlightTimer();
+	}
+
+	if (bDayActive)
+	{
+		HighlightRandomPrime();
+	}
+}
+
+/**
+ * Stress timer - raises the difficulty and shortens the highlight interval.
+ */
+void ATerminalActor::HandleStressTimer()
+{
+	if (Recorder)
+	{
+		Recorder->RecordStressTimer();
+	}
+
+	if (!bDayActive)
+	{
+		return;
+	}
+
+	++DifficultyLevel;
+
+	const float NewInterval = FMath::Max(
+		BaseHighlightInterval * FMath::Pow(HighlightIntervalScale, (float)DifficultyLevel),
+		MinHighlightInterval);
+
+	// Only re-arm if the rate actually changed (it stops changing once at the minimum)
+	if (!FMath::IsNearlyEqual(NewInterval, CurrentHighlightInterval))
+	{
+		CurrentHighlightInterval = NewInterval;
+		if (!bReplayClock)
+		{
+			GetWorldTimerManager().SetTimer(HighlightTimerHandle, this, &ATerminalActor::HandleHighlightTimer, CurrentHighlightInterval, true);
+		}
+	}
+
+	OnDifficultyIncreased(DifficultyLevel, CurrentHighlightInterval);
+}
+
+/**
+ * Checks if all four progress bars have reached 100%.
+ */
+bool ATerminalActor::AllBarsFull() const
+{
+	for (float Bar : ProgressBars)
+	{
+		if (Bar < 1.f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Virtual function called when all bars are full.
+ * Can be overridden in Blueprint for custom behavior.
+ */
+void ATerminalActor::OnAllBarsFull()
+{
+	UE_LOG(LogTemp, Warning, TEXT("All bars are full!"));
+}
+
+/**
+ * Exits terminal mode and returns camera control to the player character.
+ */
+void ATerminalActor::ExitTerminalMode()
+{
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+
+	if (PC)
+	{
+		if (APlayerCharacter* Player = Cast<APlayerCharacter>(PC->GetPawn()))
+		{
+			Player->StandUpFromTerminal();
+		}
+	}
+}
+
+/**
+ * Calculates the master progress (average of all four bars).
+ * When this reaches 1.0, the current file is complete.
+ */
+float ATerminalActor::GetMasterProgress() const
+{
+	float Total = 0.0;
+	for (float BinProgress : ProgressBars)
+	{
+		Total += BinProgress;
+	}
+
+	return FMath::Clamp(Total / 4.0f, 0.0f, 1.0f);
+}
+
+// ========================================
+// DAY / FILE MANAGEMENT
+// ========================================
+
+/**
+ * Starts a new workday.
+ * Resets counters, generates fresh grid, broadcasts start event.
+ */
+void ATerminalActor::StartDay()
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalStartDay, "Terminal.StartDay");
+
+	bDayActive = true;
+	DayStartTime = GetWorld()->GetTimeSeconds();
+	
+	ResolveMapDimensions();
+
+	if (IsNextDayReady())
+	{
+		// ========================================
+		// Fast Path: Swap in the Prebuilt Grid
+		// ========================================
+		DaySeed = NextDaySeed;
+		GridStore = MoveTemp(*NextDayGrid.Get());
+		NextDayGrid.Reset();
+		NextDayJob.Reset();
+
+		// Let other terminals on the same seed reuse it
+		if (UTerminalSubsystem* TerminalManager = GetWorld()->GetSubsystem<UTerminalSubsystem>())
+		{
+			TerminalManager->ShareGrid(GridStore);
+		}
+		OnGridRebuilt();
+	}
+	else
+	{
+		// ========================================
+		// Fallback: Build Synchronously
+		// ========================================
+		// Nothing prebuilt (or still in flight / stale) - don't wait on the worker
+		ResetNextDay();
+
+		// Each day gets its own map
+		if (bRandomizeDaySeed)
+		{
+			DaySeed = FMath::Rand();
+		}
+		GenerateGrid();
+	}
+
+	// Stores the seed actually used, so a replay doesn't depend on FMath::Rand
+	if (Recorder)
+	{
+		Recorder->RecordStartDay(DaySeed);
+	}
+
+	if (bUseDifficultySchedule)
+	{
+		StartDifficultySchedule();
+	}
+
+	OnDayStarted();
+}
+
+/**
+ * Ends the current workday.
+ * Sets active flag to false, broadcasts completion event.
+ */
+void ATerminalActor::EndDay()
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalEndDay, "Terminal.EndDay");
+
+	bDayActive = false;
+	StopDifficultySchedule();
+	ClearBarCooldowns();
+	OnDayCompleted();
+}
+
+/**
  * Called when a single file reaches 100% completion.
  * Updates counter, checks if all files for the day are done.
  */
-void ATerminalActor::OnFileWorkComplete()
+void ATerminalActor::OnFileWorkComplete()
+{
+	FilesRefinedCount++;
+
+	// Broadcast update so UI knows progress (e.g., "1/2 files complete")
+	NotifyFileCompleted();
+
+	// Check if all files for the day are complete
+	if (FilesRefinedCount >= FilesPerDay)
+	{
+		// Day is complete!
+		bDayActive = false;
+		StopDifficultySchedule();
+		ClearBarCooldowns();
+		
+		// Calculate how long the day took
+		float Duration = GetWorld()->GetTimeSeconds() - DayStartTime;
+
+		// Build tomorrow's grid in the background while the day complete screen is up
+		if (bPrebuildNextDay)
+		{
+			PrepareNextDay();
+		}
+
+		// Trigger day complete event
+		BP_OnDayComplete(Duration);
+	}
+	else
+	{
+		// More files to go - reset and show file selection
+		ResetProgressBars();
+		BP_OnShowFileSelection();
+	}
+}
+
+// ========================================
+// INFINITE SCROLLING SYSTEM
+// ========================================
+
+/**
+ * Applies mouse/trackball input to scroll the grid.
+ * Uses sub-pixel accumulation for smooth movement.
+ * Implements wrapping to create infinite grid illusion.
+ */
+void ATerminalActor::ApplyTrackballInput(float AxisX, float AxisY)
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalScroll, "Terminal.Scroll");
+	INC_DWORD_STAT(STAT_TerminalScrollEvents);
+
+	if (Recorder)
+	{
+		Recorder->RecordTrackball(AxisX, AxisY);
+	}
+
+	const int32 PreviousScrollX = ScrollX;
+	const int32 PreviousScrollY = ScrollY;
+
+	// ========================================
+	// Step 1: Accumulate Movement
+	// ========================================
+	// Multiply by -1 to invert controls (feel more natural for trackball)
+	AccumulatorX += (AxisX * -1.0f) * ScrollSensitivity;
+	AccumulatorY += (AxisY * -1.0f) * ScrollSensitivity;
+
+	// ========================================
+	// Step 2: Update Integer Scroll Positions
+	// ========================================
+	// Extract integer part of accumulated movement
+	ScrollX += (int32)AccumulatorX;
+	ScrollY += (int32)AccumulatorY;
+
+	// ========================================
+	// Step 3: Clear Integer Part from Accumulator
+	// ========================================
+	// Keep only the decimal part for smooth sub-pixel scrolling
+	AccumulatorX -= (int32)AccumulatorX;
+	AccumulatorY -= (int32)AccumulatorY;
+
+	// ========================================
+	// Step 4: Wrap Scroll Positions
+	// ========================================
+	// This creates the "Pac-Man" effect - grid wraps seamlessly
+	
+	if (GridStore.Num() > 0)
+	{
+		ScrollX = GridStore.WrapX(ScrollX);
+		ScrollY = GridStore.WrapY(ScrollY);
+	}
+
+	// ========================================
+	// Step 5: Update Sensor and Visual Grid
+	// ========================================
+	// Sub-tile movement still moves the sensor center
+	RefreshSensorProximity();
+	PublishView();
+	UpdateGridTextureWindow();
+
+	// Only rebuild the grid widget when a whole tile scrolled into view
+	if (ScrollX != PreviousScrollX || ScrollY != PreviousScrollY)
+	{
+		SyncViewport(false);
+		NotifyGridScrolled();
+	}
+}
+
+// ========================================
+// INDEX CONVERSION HELPERS
+// ========================================
+
+/**
+ * Converts a screen-space index (0-99) to a global grid index (0-999,999).
+ * Handles wrapping for the infinite grid effect.
+ */
+int32 ATerminalActor::GetGlobalIndexFromScreenIndex(int32 ScreenIndex) const
+{
+	// Grid not generated yet
+	if (GridStore.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// ========================================
+	// Step 1: Calculate Local Screen Coordinates
+	// ========================================
+	// Convert 1D index to 2D coordinates in the 10x10 visible grid
+	int32 ScreenX = ScreenIndex % GridWidth;
+	int32 ScreenY = ScreenIndex / GridWidth;
+
+	// ========================================
+	// Step 2: Calculate "Raw" Global Coordinates
+	// ========================================
+	// Add screen offset to current scroll position
+	int32 RawGlobalX = ScrollX + ScreenX;
+	int32 RawGlobalY = ScrollY + ScreenY;
+
+	// ========================================
+	// Step 3: Wrap and Convert Back to 1D Index
+	// ========================================
+	// This creates the "Pac-Man" effect in both directions
+	return GridStore.ToWrappedIndex(RawGlobalX, RawGlobalY);
+}
+
+/**
+ * Gets the number at a specific grid coordinate.
+ * Handles wrapping for any coordinate value (even negative or > grid size).
+ */
+int32 ATerminalActor::GetGridNumber(int32 GridX, int32 GridY) const
+{
+	// Grid not generated yet
+	if (GridStore.Num() == 0)
+	{
+		return 0;
+	}
+
+	// Wrap coordinates (handle large positive numbers AND negatives)
+	const int32 GlobalIdx = GridStore.ToWrappedIndex(GridX, GridY);
+
+	// Return the number at this position
+	return GridStore.GetNumber(GlobalIdx);
+}
+
+/**
+ * Reads a rectangle of numbers, scary flags and prime flags in a single pass.
+ * Each row is copied as at most two contiguous runs (split at the wrap seam).
+ */
+void ATerminalActor::FetchGridRect(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight,
+	TArray<int32>& OutNumbers, TArray<bool>& OutScary, TArray<bool>& OutPrime) const
+{
+	const int32 Count = (GridStore.Num() > 0) ? FMath::Max(RectWidth, 0) * FMath::Max(RectHeight, 0) : 0;
+	OutNumbers.SetNumUninitialized(Count);
+	OutScary.SetNumUninitialized(Count);
+	OutPrime.SetNumUninitialized(Count);
+
+	if (Count == 0)
+	{
+		return;
+	}
+
+	int32* Numbers = OutNumbers.GetData();
+	bool* Scary = OutScary.GetData();
+	bool* Prime = OutPrime.GetData();
+
+	GridStore.ForEachRectSpan(StartX, StartY, RectWidth, RectHeight,
+		[this, Numbers, Scary, Prime](int32 DestOffset, int32 GlobalIndex, int32 SpanCount)
+		{
+			GridStore.ReadNumbers(GlobalIndex, SpanCount, Numbers + DestOffset);
+			GridStore.ReadScary(GlobalIndex, SpanCount, Scary + DestOffset);
+
+			for (int32 i = DestOffset; i < DestOffset + SpanCount; ++i)
+			{
+				Prime[i] = IsPrime(Numbers[i]);
+			}
+		});
+}
+
+/**
+ * Reads the visible window in screen order.
+ */
+void ATerminalActor::FetchVisibleGrid(TArray<int32>& OutNumbers, TArray<bool>& OutScary, TArray<bool>& OutPrime) const
+{
+	FetchGridRect(ScrollX, ScrollY, GridWidth, GridHeight, OutNumbers, OutScary, OutPrime);
+}
+
+// ========================================
+// VIEWPORT RING BUFFER
+// ========================================
+
+/**
+ * Wraps a scroll difference onto the shortest signed distance around an axis.
+ */
+static int32 WrapScrollDelta(int32 Delta, int32 AxisSize)
+{
+	Delta %= AxisSize;
+	if (Delta > AxisSize / 2) Delta -= AxisSize;
+	else if (Delta < -AxisSize / 2) Delta += AxisSize;
+	return Delta;
+}
+
+/**
+ * Converts a screen-space index to its ring buffer slot.
+ */
+int32 ATerminalActor::GetViewportSlotIndex(int32 ScreenIndex) const
+{
+	if (ScreenIndex < 0 || ScreenIndex >= GridWidth * GridHeight)
+	{
+		return INDEX_NONE;
+	}
+	return GetViewportSlot(ScreenIndex % GridWidth, ScreenIndex / GridWidth);
+}
+
+/**
+ * Copies one global tile into a ring slot.
+ * Tiles is the reader handed out by FTerminalGridStore::VisitTiles.
+ */
+template<typename ReaderType>
+void ATerminalActor::FillViewportSlot(const ReaderType& Tiles, int32 Slot, int32 GlobalX, int32 GlobalY)
+{
+	const int32 GlobalIdx = Tiles.Index(GlobalX, GlobalY);
+	const int32 Number = Tiles.Number(GlobalIdx);
+
+	const bool bPrime = IsPrime(Number);
+	const bool bScary = Tiles.Scary(GlobalIdx);
+
+	GridNumbers[Slot] = Number;
+	HighlightedPrimes[Slot] = bPrime && bScary;
+	ViewportSlotGlobal[Slot] = GlobalIdx;
+
+	// Keep the highlight candidate set in sync with what's on screen
+	SetPrimeCandidate(Slot, bPrime && !bScary);
+}
+
+/**
+ * Adds or removes a ring slot from the prime candidate set.
+ * Removal swaps the last candidate into the freed position, so both are O(1).
+ */
+void ATerminalActor::SetPrimeCandidate(int32 Slot, bool bCandidate)
+{
+	const int32 Pos = PrimeCandidatePos[Slot];
+	if (bCandidate == (Pos != INDEX_NONE))
+	{
+		return;
+	}
+
+	if (bCandidate)
+	{
+		PrimeCandidatePos[Slot] = PrimeCandidateSlots.Add(Slot);
+		return;
+	}
+
+	const int32 LastSlot = PrimeCandidateSlots.Last();
+	PrimeCandidateSlots[Pos] = LastSlot;
+	PrimeCandidatePos[LastSlot] = Pos;
+	PrimeCandidateSlots.Pop();
+	PrimeCandidatePos[Slot] = INDEX_NONE;
+}
+
+// ========================================
+// EVENTS
+// ========================================
+
+/**
+ * Looked up per call: the subsystem map lookup is cheap, and a cached pointer
+ * would outlive the world when the actor is moved between worlds in the editor.
+ */
+UTerminalEventBus* ATerminalActor::GetEventBus() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UTerminalEventBus>() : nullptr;
+}
+
+/**
+ * Any on-screen tile change (scroll, drop, highlight, replicated tile) also
+ * invalidates a snake search that read the old tiles.
+ */
+void ATerminalActor::NotifyViewportDelta()
+{
+	bSnakeSearchStale = true;
+	OnViewportDelta(ViewportDelta);
+}
+
+/**
+ * Single place OnGridScrolled is raised from, so `stat Terminal` can count the
+ * Blueprint work it triggers per frame.
+ */
+void ATerminalActor::NotifyGridScrolled()
+{
+	INC_DWORD_STAT(STAT_TerminalGridScrolledBroadcasts);
+
+	UTerminalEventBus* EventBus = GetEventBus();
+	if (EventBus)
+	{
+		EventBus->PostGridScrolled(this);
+	}
+	if (!EventBus || !bCoalesceEvents)
+	{
+		OnGridScrolled();
+	}
+}
+
+void ATerminalActor::NotifyProgressUpdated(int32 BarIndex, float NewValue)
+{
+	UTerminalEventBus* EventBus = GetEventBus();
+	if (EventBus)
+	{
+		EventBus->PostProgressUpdated(this, BarIndex, NewValue);
+	}
+	if (!EventBus || !bCoalesceEvents)
+	{
+		OnProgressUpdated(BarIndex, NewValue);
+	}
+}
+
+void ATerminalActor::NotifyChunkConsumed()
+{
+	UTerminalEventBus* EventBus = GetEventBus();
+	if (EventBus)
+	{
+		EventBus->PostChunkConsumed(this);
+	}
+	if (!EventBus || !bCoalesceEvents)
+	{
+		OnChunkConsumed();
+	}
+}
+
+void ATerminalActor::NotifyFileCompleted()
+{
+	UTerminalEventBus* EventBus = GetEventBus();
+	if (EventBus)
+	{
+		EventBus->PostFileCompleted(this, FilesRefinedCount, FilesPerDay);
+	}
+	if (!EventBus || !bCoalesceEvents)
+	{
+		OnFileCompleted(FilesRefinedCount, FilesPerDay);
+	}
+}
+
+/**
+ * Coalesced events reach Blueprint with their final values: one OnProgressUpdated
+ * per changed bar, one OnGridScrolled per frame however far the grid moved.
+ */
+void ATerminalActor::DispatchTerminalEvent(const FTerminalEvent& Event)
+{
+	switch (Event.Type)
+	{
+	case ETerminalEventType::ProgressUpdated:
+		OnProgressUpdated(Event.Index, Event.Value);
+		break;
+	case ETerminalEventType::ChunkConsumed:
+		OnChunkConsumed();
+		break;
+	case ETerminalEventType::GridScrolled:
+		OnGridScrolled();
+		break;
+	case ETerminalEventType::FileCompleted:
+		OnFileCompleted(Event.Index, Event.Count);
+		break;
+	}
+}
+
+/**
+ * Updates the ring buffer for the current scroll position.
+ *
+ * Scrolling right by N tiles rotates the ring so the N columns that left on the
+ * left now represent the N columns entering on the right, and only those are
+ * re-read from the grid store. Rows work the same way. Any jump of a full window
+ * or more (or an explicit request) refills everything.
+ */
+void ATerminalActor::SyncViewport(bool bForceFullRefresh)
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalSyncViewport, "Terminal.SyncViewport");
+
+	const int32 SlotCount = GridWidth * GridHeight;
+	if (GridStore.Num() == 0 || SlotCount <= 0)
+	{
+		return;
+	}
+
+	// Window was resized - start over
+	if (GridNumbers.Num() != SlotCount || HighlightedPrimes.Num() != SlotCount || ViewportSlotGlobal.Num() != SlotCount)
+	{
+		GridNumbers.Init(0, SlotCount);
+		HighlightedPrimes.Init(false, SlotCount);
+		ViewportSlotGlobal.Init(INDEX_NONE, SlotCount);
+		PrimeCandidatePos.Init(INDEX_NONE, SlotCount);
+		PrimeCandidateSlots.Reset(SlotCount);
+		bForceFullRefresh = true;
+	}
+
+	// Streamed grids: keep the sectors under the view and the sensor radius resident
+	const int32 SensorReach = FMath::CeilToInt(MaxSensorDistance);
+	GridStore.PrefetchSectors(ScrollX - SensorReach, ScrollY - SensorReach,
+		ScrollX + GridWidth + SensorReach, ScrollY + GridHeight + SensorReach);
+
+	const int32 ShiftX = WrapScrollDelta(ScrollX - ViewportScrollX, GridStore.GetWidth());
+	const int32 ShiftY = WrapScrollDelta(ScrollY - ViewportScrollY, GridStore.GetHeight());
+
+	ViewportDelta.ShiftX = ShiftX;
+	ViewportDelta.ShiftY = ShiftY;
+	ViewportDelta.ChangedSlots.Reset();
+	ViewportDelta.bFullRefresh = bForceFullRefresh || !bViewportValid
+		|| FMath::Abs(ShiftX) >= GridWidth || FMath::Abs(ShiftY) >= GridHeight;
+
+	// Mode and wrap are resolved once for all the tiles filled below
+	GridStore.VisitTiles([&](const auto& Tiles)
+	{
+		if (ViewportDelta.bFullRefresh)
+		{
+			// ========================================
+			// Full Refill
+			// ========================================
+			ViewportRingX = 0;
+			ViewportRingY = 0;
+
+			for (int32 ScreenY = 0; ScreenY < GridHeight; ++ScreenY)
+			{
+				for (int32 ScreenX = 0; ScreenX < GridWidth; ++ScreenX)
+				{
+					const int32 Slot = GetViewportSlot(ScreenX, ScreenY);
+					FillViewportSlot(Tiles, Slot, ScrollX + ScreenX, ScrollY + ScreenY);
+					ViewportDelta.ChangedSlots.Add(Slot);
+				}
+			}
+		}
+		else
+		{
+			// ========================================
+			// Entering Columns
+			// ========================================
+			// Rows haven't moved yet, so columns are filled against the old Y
+			if (ShiftX != 0)
+			{
+				ViewportRingX = (ViewportRingX + ShiftX + GridWidth) % GridWidth;
+
+				const int32 FirstColumn = ShiftX > 0 ? GridWidth - ShiftX : 0;
+				const int32 LastColumn = FirstColumn + FMath::Abs(ShiftX);
+				for (int32 ScreenY = 0; ScreenY < GridHeight; ++ScreenY)
+				{
+					for (int32 ScreenX = FirstColumn; ScreenX < LastColumn; ++ScreenX)
+					{
+						const int32 Slot = GetViewportSlot(ScreenX, ScreenY);
+						FillViewportSlot(Tiles, Slot, ScrollX + ScreenX, ViewportScrollY + ScreenY);
+						ViewportDelta.ChangedSlots.Add(Slot);
+					}
+				}
+			}
+
+			// ========================================
+			// Entering Rows
+			// ========================================
+			if (ShiftY != 0)
+			{
+				ViewportRingY = (ViewportRingY + ShiftY + GridHeight) % GridHeight;
+
+				const int32 FirstRow = ShiftY > 0 ? GridHeight - ShiftY : 0;
+				const int32 LastRow = FirstRow + FMath::Abs(ShiftY);
+				for (int32 ScreenY = FirstRow; ScreenY < LastRow; ++ScreenY)
+				{
+					for (int32 ScreenX = 0; ScreenX < GridWidth; ++ScreenX)
+					{
+						const int32 Slot = GetViewportSlot(ScreenX, ScreenY);
+						FillViewportSlot(Tiles, Slot, ScrollX + ScreenX, ScrollY + ScreenY);
+						ViewportDelta.ChangedSlots.AddUnique(Slot); // Corner may already be listed
+					}
+				}
+			}
+		}
+	});
+
+	ViewportScrollX = ScrollX;
+	ViewportScrollY = ScrollY;
+	ViewportDelta.RingOffsetX = ViewportRingX;
+	ViewportDelta.RingOffsetY = ViewportRingY;
+	bViewportValid = true;
+
+	SyncGridTexture(ViewportDelta.bFullRefresh);
+
+	RebuildViewportPrimes();
+
+	if (ViewportDelta.ChangedSlots.Num() > 0)
+	{
+		NotifyViewportDelta();
+	}
+}
+
+/**
+ * Re-reads a single global tile into the ring buffer if it is on screen.
+ */
+int32 ATerminalActor::RefreshViewportTile(int32 GlobalIndex)
+{
+	// The texture window is larger than the view, so update it before the visibility check
+	UpdateGridTextureTile(GlobalIndex);
+
+	if (!bViewportValid || GridNumbers.Num() != GridWidth * GridHeight || !GridStore.IsValidIndex(GlobalIndex))
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 MapWidth = GridStore.GetWidth();
+	const int32 MapHeight = GridStore.GetHeight();
+
+	// Offset of the tile from the top-left of the view, wrapped onto [0, MapSize)
+	int32 ScreenX = (GlobalIndex % MapWidth - ViewportScrollX) % MapWidth;
+	if (ScreenX < 0) ScreenX += MapWidth;
+
+	int32 ScreenY = (GlobalIndex / MapWidth - ViewportScrollY) % MapHeight;
+	if (ScreenY < 0) ScreenY += MapHeight;
+
+	if (ScreenX >= GridWidth || ScreenY >= GridHeight)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Slot = GetViewportSlot(ScreenX, ScreenY);
+	GridStore.VisitTiles([&](const auto& Tiles)
+	{
+		FillViewportSlot(Tiles, Slot, ViewportScrollX + ScreenX, ViewportScrollY + ScreenY);
+	});
+	return Slot;
+}
+
+// ========================================
+// GRID TEXTURE
+// ========================================
+
+/**
+ * Creates the texel window (view plus border on every side) and binds it to the screen.
+ */
+void ATerminalActor::InitGridTexture()
+{
+	GridTexture = GridTexels.Init(GridWidth + 2 * GridTextureBorder, GridHeight + 2 * GridTextureBorder);
+
+	if (!ScreenMaterial && CRTMonitor)
+	{
+		ScreenMaterial = CRTMonitor->CreateDynamicMaterialInstance(ScreenMaterialIndex);
+	}
+	if (ScreenMaterial && GridTexture)
+	{
+		ScreenMaterial->SetTextureParameterValue(GridTextureParameterName, GridTexture);
+	}
+}
+
+/**
+ * Same ring-buffer update as SyncViewport, over the larger texel window.
+ * Columns are written against the old Y origin, then rows against the new one,
+ * so the corner is covered exactly once.
+ */
+void ATerminalActor::SyncGridTexture(bool bForceFullRefresh)
+{
+	if (!bUseGridTexture || GridStore.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 TextureWidth = GridWidth + 2 * GridTextureBorder;
+	const int32 TextureHeight = GridHeight + 2 * GridTextureBorder;
+
+	// First sync or window resized
+	if (!GridTexture || GridTexels.GetWidth() != TextureWidth || GridTexels.GetHeight() != TextureHeight)
+	{
+		InitGridTexture();
+		bForceFullRefresh = true;
+	}
+
+	const int32 OriginX = ScrollX - GridTextureBorder;
+	const int32 OriginY = ScrollY - GridTextureBorder;
+	const int32 ShiftX = WrapScrollDelta(OriginX - GridTextureScrollX, GridStore.GetWidth());
+	const int32 ShiftY = WrapScrollDelta(OriginY - GridTextureScrollY, GridStore.GetHeight());
+
+	if (bForceFullRefresh || !GridTexels.IsValid()
+		|| FMath::Abs(ShiftX) >= TextureWidth || FMath::Abs(ShiftY) >= TextureHeight)
+	{
+		// ========================================
+		// Full Refill
+		// ========================================
+		WriteGridTextureRect(OriginX, OriginY, 0, 0, TextureWidth, TextureHeight);
+		GridTexels.MarkValid();
+	}
+	else
+	{
+		// ========================================
+		// Entering Columns
+		// ========================================
+		if (ShiftX != 0)
+		{
+			GridTexels.Scroll(ShiftX, 0);
+			const int32 FirstColumn = ShiftX > 0 ? TextureWidth - ShiftX : 0;
+			WriteGridTextureRect(OriginX, GridTextureScrollY, FirstColumn, 0, FMath::Abs(ShiftX), TextureHeight);
+		}
+
+		// ========================================
+		// Entering Rows
+		// ========================================
+		if (ShiftY != 0)
+		{
+			GridTexels.Scroll(0, ShiftY);
+			const int32 FirstRow = ShiftY > 0 ? TextureHeight - ShiftY : 0;
+			WriteGridTextureRect(OriginX, OriginY, 0, FirstRow, TextureWidth, FMath::Abs(ShiftY));
+		}
+	}
+
+	GridTextureScrollX = GridStore.WrapX(OriginX);
+	GridTextureScrollY = GridStore.WrapY(OriginY);
+
+	UpdateGridTextureWindow();
+	GridTexels.Flush();
+}
+
+/**
+ * Packs a rectangle of tiles into texels with one bulk read from the grid store.
+ */
+void ATerminalActor::WriteGridTextureRect(int32 OriginX, int32 OriginY, int32 WindowX, int32 WindowY, int32 RectWidth, int32 RectHeight)
+{
+	TArray<int32> Numbers;
+	TArray<bool> Scary;
+	TArray<bool> Prime;
+	FetchGridRect(OriginX + WindowX, OriginY + WindowY, RectWidth, RectHeight, Numbers, Scary, Prime);
+
+	if (Numbers.Num() != RectWidth * RectHeight)
+	{
+		return;
+	}
+
+	for (int32 Y = 0; Y < RectHeight; ++Y)
+	{
+		for (int32 X = 0; X < RectWidth; ++X)
+		{
+			const int32 i = Y * RectWidth + X;
+			GridTexels.SetTexel(WindowX + X, WindowY + Y, TerminalGridTexel::Pack(Numbers[i], Scary[i], Prime[i]));
+		}
+	}
+	GridTexels.MarkDirty(WindowX, WindowY, RectWidth, RectHeight);
+}
+
+/**
+ * Re-packs one tile if it lies in the texel window.
+ */
+void ATerminalActor::UpdateGridTextureTile(int32 GlobalIndex)
 {
-	FilesRefinedCount++;
+	if (!bUseGridTexture || !GridTexels.IsValid() || !GridStore.IsValidIndex(GlobalIndex))
+	{
+		return;
+	}
 
-	// Broadcast update so UI knows progress (e.g., "1/2 files complete")
-	OnFileCompleted(FilesRefinedCount, FilesPerDay);
+	const int32 MapWidth = GridStore.GetWidth();
+	const int32 MapHeight = GridStore.GetHeight();
 
-	// Check if all files for the day are complete
-	if (FilesRefinedCount >= FilesPerDay)
+	// Offset of the tile from the texel window origin, wrapped onto [0, MapSize)
+	int32 WindowX = (GlobalIndex % MapWidth - GridTextureScrollX) % MapWidth;
+	if (WindowX < 0) WindowX += MapWidth;
+
+	int32 WindowY = (GlobalIndex / MapWidth - GridTextureScrollY) % MapHeight;
+	if (WindowY < 0) WindowY += MapHeight;
+
+	if (WindowX >= GridTexels.GetWidth() || WindowY >= GridTexels.GetHeight())
 	{
-		// Day is complete!
-		bDayActive = false;
-		
-		// Calculate how long the day took
-		float Duration = GetWorld()->GetTimeSeconds() - DayStartTime;
+		return;
+	}
 
-		// Trigger day complete event
-		BP_OnDayComplete(Duration);
+	const int32 Number = GridStore.GetNumber(GlobalIndex);
+	GridTexels.UpdateTexel(WindowX, WindowY, TerminalGridTexel::Pack(Number, GridStore.IsScary(GlobalIndex), IsPrime(Number)));
+}
+
+/**
+ * Sub-tile scrolling is only a UV offset, so this runs on every trackball move.
+ */
+void ATerminalActor::UpdateGridTextureWindow()
+{
+	if (!ScreenMaterial || !GridTexels.IsValid())
+	{
+		return;
 	}
-	else
+
+	const float TextureWidth = (float)GridTexels.GetWidth();
+	const float TextureHeight = (float)GridTexels.GetHeight();
+
+	ScreenMaterial->SetVectorParameterValue(GridWindowParameterName, FLinearColor(
+		(GridTexels.GetRingX() + GridTextureBorder + AccumulatorX) / TextureWidth,
+		(GridTexels.GetRingY() + GridTextureBorder + AccumulatorY) / TextureHeight,
+		GridWidth / TextureWidth,
+		GridHeight / TextureHeight));
+}
+
+/**
+ * Rebuilds the list of visible primes (as global indices) from the ring buffer.
+ */
+void ATerminalActor::RebuildViewportPrimes()
+{
+	PrimeIndices.Reset();
+
+	// Ring not filled (or stale after a resize) - SyncViewport will rebuild it
+	if (!bViewportValid || GridNumbers.Num() != GridWidth * GridHeight)
 	{
-		// More files to go - reset and show file selection
-		ResetProgressBars();
-		BP_OnShowFileSelection();
+		return;
+	}
+
+	for (int32 ScreenY = 0; ScreenY < GridHeight; ++ScreenY)
+	{
+		for (int32 ScreenX = 0; ScreenX < GridWidth; ++ScreenX)
+		{
+			if (IsPrime(GridNumbers[GetViewportSlot(ScreenX, ScreenY)]))
+			{
+				PrimeIndices.Add(GridStore.ToWrappedIndex(ViewportScrollX + ScreenX, ViewportScrollY + ScreenY));
+			}
+		}
 	}
 }
 
 // ========================================
-// INFINITE SCROLLING SYSTEM
+// SCARY NUMBER DROP SYSTEM
 // ========================================
 
 /**
- * Applies mouse/trackball input to scroll the grid.
- * Uses sub-pixel accumulation for smooth movement.
- * Implements wrapping to create infinite grid illusion.
+ * Gets a 3x3 group of indices around a center point.
+ * Used for visual grouping or special effects.
  */
-void ATerminalActor::ApplyTrackballInput(float AxisX, float AxisY)
+TArray<int32> ATerminalActor::Get3x3Group(int32 CenterIndex) const
 {
-	// ========================================
-	// Step 1: Accumulate Movement
-	// ========================================
-	// Multiply by -1 to invert controls (feel more natural for trackball)
-	AccumulatorX += (AxisX * -1.0f) * ScrollSensitivity;
-	AccumulatorY += (AxisY * -1.0f) * ScrollSensitivity;
-
-	// ========================================
-	// Step 2: Update Integer Scroll Positions
-	// ========================================
-	// Extract integer part of accumulated movement
-	ScrollX += (int32)AccumulatorX;
-	ScrollY += (int32)AccumulatorY;
+	TArray<int32, TFixedAllocator<9>> Group;
+	Get3x3GroupInto(CenterIndex, Group);
+	return TArray<int32>(Group);
+}
 
-	// ========================================
-	// Step 3: Clear Integer Part from Accumulator
-	// ========================================
-	// Keep only the decimal part for smooth sub-pixel scrolling
-	AccumulatorX -= (int32)AccumulatorX;
-	AccumulatorY -= (int32)AccumulatorY;
+/**
+ * Fills a fixed-capacity array with the 3x3 group around a center point.
+ * Tiles past the map edges are skipped (the group does not wrap).
+ */
+void ATerminalActor::Get3x3GroupInto(int32 CenterIndex, TArray<int32, TFixedAllocator<9>>& OutGroup) const
+{
+	OutGroup.Reset();
 
-	// ========================================
-	// Step 4: Wrap Scroll Positions
-	// ========================================
-	// This creates the "Pac-Man" effect - grid wraps seamlessly
-	
-	// Wrap X coordinate
-	ScrollX = ScrollX % GlobalMapWidth;
-	if (ScrollX < 0) ScrollX += GlobalMapWidth;
+	const int32 MapWidth = GridStore.GetWidth();
+	const int32 MapHeight = GridStore.GetHeight();
+	if (!GridStore.IsValidIndex(CenterIndex))
+	{
+		return;
+	}
 
-	// Wrap Y coordinate
-	ScrollY = ScrollY % GlobalMapHeight;
-	if (ScrollY < 0) ScrollY += GlobalMapHeight;
+	// Convert center index to 2D coordinates
+	const int32 CenterX = CenterIndex % MapWidth;
+	const int32 CenterY = CenterIndex / MapWidth;
 
-	// ========================================
-	// Step 5: Update Visual Grid
-	// ========================================
-	OnGridScrolled();
+	// Gather 3x3 grid around center
+	for (int32 y = CenterY - 1; y <= CenterY + 1; ++y)
+	{
+		for (int32 x = CenterX - 1; x <= CenterX + 1; ++x)
+		{
+			// Only add if within bounds
+			if (x >= 0 && x < MapWidth && y >= 0 && y < MapHeight)
+			{
+				OutGroup.Add(y * MapWidth + x);
+			}
+		}
+	}
 }
 
 // ========================================
-// INDEX CONVERSION HELPERS
+// SNAKE HINTS
 // ========================================
 
 /**
- * Converts a screen-space index (0-99) to a global grid index (0-999,999).
- * Handles wrapping for the infinite grid effect.
+ * Runs a whole search in one call.
  */
-int32 ATerminalActor::GetGlobalIndexFromScreenIndex(int32 ScreenIndex) const
+int32 ATerminalActor::FindBestSnakes(const FTerminalSnakeSearchSettings& Settings, TArray<FTerminalSnake>& OutSnakes)
 {
-	// ========================================
-	// Step 1: Calculate Local Screen Coordinates
-	// ========================================
-	// Convert 1D index to 2D coordinates in the 10x10 visible grid
-	int32 ScreenX = ScreenIndex % GridWidth;
-	int32 ScreenY = ScreenIndex / GridWidth;
-
-	// ========================================
-	// Step 2: Calculate "Raw" Global Coordinates
-	// ========================================
-	// Add screen offset to current scroll position
-	int32 RawGlobalX = ScrollX + ScreenX;
-	int32 RawGlobalY = ScrollY + ScreenY;
+	OutSnakes.Reset();
+	if (!BeginSnakeSearch(Settings))
+	{
+		return 0;
+	}
 
-	// ========================================
-	// Step 3: Wrap X Coordinate (Handle Negatives)
-	// ========================================
-	// This creates the "Pac-Man" effect horizontally
-	int32 WrappedX = RawGlobalX % GlobalMapWidth;
-	if (WrappedX < 0) WrappedX += GlobalMapWidth;
+	ContinueSnakeSearch(0.f, OutSnakes);
+	return OutSnakes.Num();
+}
 
-	// ========================================
-	// Step 4: Wrap Y Coordinate
-	// ========================================
-	// This creates the "Pac-Man" effect vertically
-	int32 WrappedY = RawGlobalY % GlobalMapHeight;
-	if (WrappedY < 0) WrappedY += GlobalMapHeight;
+/**
+ * Reads the window plus border once; the search then only touches its own buffers.
+ */
+bool ATerminalActor::BeginSnakeSearch(const FTerminalSnakeSearchSettings& Settings)
+{
+	SnakeSearchSettings = Settings;
+	SnakeSearchScrollX = ScrollX;
+	SnakeSearchScrollY = ScrollY;
+	bSnakeSearchStale = false;
+
+	const int32 Border = FMath::Clamp(Settings.Border, 0, 3);
+	const int32 SearchWidth = GridWidth + 2 * Border;
+	const int32 SearchHeight = GridHeight + 2 * Border;
+	if (GridStore.Num() == 0 || SearchWidth * SearchHeight > FTerminalSnakeSearch::MaxCells)
+	{
+		SnakeSearch.Begin(0, 0, {}, {}, Settings);
+		return false;
+	}
 
-	// ========================================
-	// Step 5: Convert Back to 1D Index
-	// ========================================
-	return WrappedY * GlobalMapWidth + WrappedX;
+	FetchGridRect(ScrollX - Border, ScrollY - Border, SearchWidth, SearchHeight, SnakeSearchNumbers, SnakeSearchScary, SnakeSearchPrime);
+	return SnakeSearch.Begin(SearchWidth, SearchHeight, SnakeSearchNumbers, SnakeSearchScary, Settings);
 }
 
 /**
- * Gets the number at a specific grid coordinate.
- * Handles wrapping for any coordinate value (even negative or > grid size).
+ * One budgeted slice. Results always describe the window the search started on,
+ * so a scroll or a tile change (e.g. a drop rerolling tiles) restarts it rather
+ * than returning snakes at the wrong place or made of eaten tiles.
  */
-int32 ATerminalActor::GetGridNumber(int32 GridX, int32 GridY) const
+bool ATerminalActor::ContinueSnakeSearch(float BudgetMicroseconds, TArray<FTerminalSnake>& OutSnakes)
 {
-	// Wrap X coordinate (handle large positive numbers AND negatives)
-	int32 WrappedX = GridX % GlobalMapWidth;
-	if (WrappedX < 0) WrappedX += GlobalMapWidth;
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalSnakeSearch, "Terminal.SnakeSearch");
 
-	// Wrap Y coordinate
-	int32 WrappedY = GridY % GlobalMapHeight;
-	if (WrappedY < 0) WrappedY += GlobalMapHeight;
+	if (bSnakeSearchStale || SnakeSearchScrollX != ScrollX || SnakeSearchScrollY != ScrollY)
+	{
+		BeginSnakeSearch(SnakeSearchSettings);
+	}
 
-	// Calculate index using the safe, wrapped coordinates
-	int32 GlobalIdx = WrappedY * GlobalMapWidth + WrappedX;
+	const bool bFinished = SnakeSearch.Step(BudgetMicroseconds * 1e-6);
+	GetSnakeSearchResults(OutSnakes);
+	return bFinished;
+}
 
-	// Return the number at this position
-	if (GlobalGridNumbers.IsValidIndex(GlobalIdx))
+/**
+ * Window cells become screen indices; cells in the border have none.
+ */
+void ATerminalActor::GetSnakeSearchResults(TArray<FTerminalSnake>& OutSnakes)
+{
+	const int32 Border = (SnakeSearch.GetWidth() - GridWidth) / 2;
+	const int32 SearchWidth = SnakeSearch.GetWidth();
+
+	OutSnakes.SetNum(SnakeSearch.GetResultCount());
+
+	for (int32 ResultIndex = 0; ResultIndex < OutSnakes.Num(); ++ResultIndex)
 	{
-		return GlobalGridNumbers[GlobalIdx];
+		int32 Score = 0;
+		FTerminalSnake& Snake = OutSnakes[ResultIndex];
+		SnakeSearch.GetResult(ResultIndex, SnakeSearchCells, Score, Snake.ScaryCount);
+
+		Snake.Value = Score * FTerminalSnakeSearch::ValuePerPoint;
+		Snake.bFullyVisible = true;
+		Snake.ScreenIndices.Reset(SnakeSearchCells.Num());
+		for (const int32 Cell : SnakeSearchCells)
+		{
+			const int32 ScreenX = Cell % SearchWidth - Border;
+			const int32 ScreenY = Cell / SearchWidth - Border;
+			const bool bVisible = ScreenX >= 0 && ScreenX < GridWidth && ScreenY >= 0 && ScreenY < GridHeight;
+			Snake.ScreenIndices.Add(bVisible ? ScreenY * GridWidth + ScreenX : INDEX_NONE);
+			Snake.bFullyVisible &= bVisible;
+		}
 	}
-    
-	return 0;
 }
 
 // ========================================
-// SCARY NUMBER DROP SYSTEM
+// SCARY DENSITY
 // ========================================
 
 /**
- * Gets a 3x3 group of indices around a center point.
- * Used for visual grouping or special effects.
+ * Sector-resolution count from the density table; never touches the cells.
  */
-TArray<int32> ATerminalActor::Get3x3Group(int32 CenterIndex) const
+int32 ATerminalActor::CountScaryInRect(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight) const
 {
-	TArray<int32> Group;
-	
-	// Convert center index to 2D coordinates
-	int32 CenterX = CenterIndex % GlobalMapWidth;
-	int32 CenterY = CenterIndex / GlobalMapWidth;
+	if (GridStore.Num() == 0)
+	{
+		return 0;
+	}
 
-	// Gather 3x3 grid around center
-	for (int32 y = CenterY - 1; y <= CenterY + 1; ++y)
+	return GridStore.GetScaryDensity().CountInRect(StartX, StartY, RectWidth, RectHeight);
+}
+
+/**
+ * Square window around the point, same as the sensor search.
+ */
+int32 ATerminalActor::CountScaryInRadius(float CenterX, float CenterY, float Radius) const
+{
+	if (GridStore.Num() == 0)
 	{
-		for (int32 x = CenterX - 1; x <= CenterX + 1; ++x)
+		return 0;
+	}
+
+	return GridStore.GetScaryDensity().CountInRadius(CenterX, CenterY, Radius);
+}
+
+/**
+ * Uses the same screen center as GetDistanceToNearestScary.
+ */
+int32 ATerminalActor::CountScaryNearView(float Radius) const
+{
+	const float CenterX = (float)ScrollX + AccumulatorX + (GridWidth - 1) * 0.5f;
+	const float CenterY = (float)ScrollY + AccumulatorY + (GridHeight - 1) * 0.5f;
+	return CountScaryInRadius(CenterX, CenterY, Radius);
+}
+
+/**
+ * The texture is tiny (20x20 for the default map), so any change re-uploads all of it.
+ * The density revision changes on every scary flip and on every new grid, so an
+ * unchanged map costs one comparison.
+ */
+UTexture2D* ATerminalActor::GetScaryDensityTexture()
+{
+	if (GridStore.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const FTerminalScaryDensity& Density = GridStore.GetScaryDensity();
+	const int32 TextureWidth = Density.GetSectorsX();
+	const int32 TextureHeight = Density.GetSectorsY();
+
+	// ========================================
+	// Step 1: Create for the Map Size
+	// ========================================
+	if (!ScaryDensityTexture || ScaryDensityTexture->GetSizeX() != TextureWidth || ScaryDensityTexture->GetSizeY() != TextureHeight)
+	{
+		// Bilinear so the minimap reads as a heatmap; wraps like the map
+		ScaryDensityTexture = UTexture2D::CreateTransient(TextureWidth, TextureHeight, PF_G8);
+		if (!ScaryDensityTexture)
 		{
-			// Only add if within bounds
-			if (x >= 0 && x < GlobalMapWidth && y >= 0 && y < GlobalMapHeight)
-			{
-				Group.Add(y * GlobalMapWidth + x);
-			}
+			return nullptr;
 		}
+
+		ScaryDensityTexture->Filter = TF_Bilinear;
+		ScaryDensityTexture->SRGB = false;
+		ScaryDensityTexture->AddressX = TA_Wrap;
+		ScaryDensityTexture->AddressY = TA_Wrap;
+		ScaryDensityTexture->LODGroup = TEXTUREGROUP_Pixels2D;
+		ScaryDensityTexture->UpdateResource();
+		ScaryDensityTextureRevision = 0;
 	}
-	
-	return Group;
+
+	if (ScaryDensityTextureRevision == Density.GetRevision())
+	{
+		return ScaryDensityTexture;
+	}
+
+	// ========================================
+	// Step 2: Upload
+	// ========================================
+	// The render thread copies after this returns, so it gets its own buffer and region
+	TArray<uint8> Texels;
+	Density.WriteTexels(Texels, ScaryDensityFullCount);
+
+	uint8* SourceData = (uint8*)FMemory::Malloc(Texels.Num());
+	FMemory::Memcpy(SourceData, Texels.GetData(), Texels.Num());
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, TextureWidth, TextureHeight);
+
+	ScaryDensityTexture->UpdateTextureRegions(0, 1, Region, TextureWidth, 1, SourceData,
+		[](uint8* InSourceData, const FUpdateTextureRegion2D* InRegions)
+		{
+			FMemory::Free(InSourceData);
+			delete InRegions;
+		});
+
+	ScaryDensityTextureRevision = Density.GetRevision();
+	return ScaryDensityTexture;
+}
+
+/**
+ * Blueprint entry point for snake drops - forwards to the batched native path.
+ */
+void ATerminalActor::HandleScaryDrop(const TArray<int32>& TileIndices, int32 BarIndex)
+{
+	HandleScaryDropSpan(TConstArrayView<int32>(TileIndices), BarIndex);
 }
 
 /**
@@ -622,64 +2997,133 @@ TArray<int32> ATerminalActor::Get3x3Group(int32 CenterIndex) const
  * 3. Consume scary numbers (turn them back to normal)
  * 4. Replace eaten numbers with fresh random numbers
  * 5. Apply total value to the selected progress bar
+ * 
+ * The viewport is validated once up front; after that every tile is read straight
+ * from the ring buffer (number and global index), with no per-tile wrap math.
  */
-void ATerminalActor::HandleScaryDrop(const TArray<int32>& TileIndices, int32 BarIndex)
+float ATerminalActor::HandleScaryDropSpan(TConstArrayView<int32> TileIndices, int32 BarIndex)
 {
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalDropScoring, "Terminal.DropScoring");
+
+	if (Recorder)
+	{
+		Recorder->RecordDrop(TileIndices, BarIndex);
+	}
+
+	// A full or cooling bar would reject the chunk, so don't eat the tiles for nothing
+	if (!IsBarAvailable(BarIndex))
+	{
+		return 0.f;
+	}
+
+	// ========================================
+	// Step 1: Validate the Viewport Once
+	// ========================================
+	// Screen indices are only meaningful against the current scroll position
+	if (!bViewportValid || ViewportScrollX != ScrollX || ViewportScrollY != ScrollY)
+	{
+		SyncViewport(false);
+	}
+	if (!bViewportValid)
+	{
+		return 0.f;
+	}
+
+	const uint32 SlotCount = (uint32)(GridWidth * GridHeight);
 	float TotalValueFromSnake = 0.0f;
+	bool bScaryConsumed = false;
+	bool bPrimesChanged = false;
+
+	ViewportDelta.ShiftX = 0;
+	ViewportDelta.ShiftY = 0;
+	ViewportDelta.bFullRefresh = false;
+	ViewportDelta.ChangedSlots.Reset();
 
 	// Process each tile in the snake
-	for (int32 ScreenIdx : TileIndices)
+	for (const int32 ScreenIdx : TileIndices)
 	{
+		// Off-screen indices can't be part of a snake
+		if ((uint32)ScreenIdx >= SlotCount)
+		{
+			continue;
+		}
+
+		const int32 Slot = GetViewportSlot(ScreenIdx % GridWidth, ScreenIdx / GridWidth);
+		const int32 GlobalIdx = ViewportSlotGlobal[Slot];
+		const int32 NumberValue = GridNumbers[Slot];
+
 		// ========================================
-		// Step 1: Convert Screen Index to Global Index
+		// Step 2: Calculate Base Progress
 		// ========================================
-		int32 GlobalIdx = GetGlobalIndexFromScreenIndex(ScreenIdx);
-        
-		if (GlobalGridNumbers.IsValidIndex(GlobalIdx))
+		// Higher numbers = more progress
+		// Example: a '9' gives 0.045, a '1' gives 0.005
+		float ProgressContribution = (float)NumberValue * 0.005f;
+
+		// ========================================
+		// Step 3: Apply Scary Multiplier
+		// ========================================
+		if (GridStore.IsScary(GlobalIdx))
 		{
-			// ========================================
-			// Step 2: Get Number Value (1-9)
-			// ========================================
-			int32 NumberValue = GlobalGridNumbers[GlobalIdx];
-            
-			// ========================================
-			// Step 3: Calculate Base Progress
-			// ========================================
-			// Higher numbers = more progress
-			// Example: a '9' gives 0.045, a '1' gives 0.005
-			float ProgressContribution = (float)NumberValue * 0.005f;
+			ProgressContribution *= 4.0f; // 4x bonus for red numbers!
+			GridStore.SetScary(GlobalIdx, false); // "Consume" the scary state
+			bScaryConsumed = true;
+		}
 
-			// ========================================
-			// Step 4: Apply Scary Multiplier
-			// ========================================
-			if (ScaryActive.IsValidIndex(GlobalIdx) && ScaryActive[GlobalIdx])
-			{
-				ProgressContribution *= 4.0f; // 4x bonus for red numbers!
-				ScaryActive[GlobalIdx] = false; // "Consume" the scary state
-			}
+		// ========================================
+		// Step 4: Replace with New Number
+		// ========================================
+		// Refresh the tile so player can't eat the same number twice
+		const int32 NewNumber = GridRandomStream.RandRange(1, 9);
+		GridStore.SetNumber(GlobalIdx, NewNumber);
+		PublishTile(GlobalIdx);
+		UpdateGridTextureTile(GlobalIdx);
+
+		// Patch the ring slot in place (the tile is never scary after being eaten)
+		bPrimesChanged |= IsPrime(NumberValue) != IsPrime(NewNumber);
+		GridNumbers[Slot] = NewNumber;
+		HighlightedPrimes[Slot] = false;
+		SetPrimeCandidate(Slot, IsPrime(NewNumber));
+		ViewportDelta.ChangedSlots.AddUnique(Slot);
+
+		// Add to total value
+		TotalValueFromSnake += ProgressContribution;
+	}
 
-			// ========================================
-			// Step 5: Replace with New Number
-			// ========================================
-			// Refresh the tile so player can't eat the same number twice
-			GlobalGridNumbers[GlobalIdx] = FMath::RandRange(1, 9);
-            
-			// Add to total value
-			TotalValueFromSnake += ProgressContribution;
-		}
+	// Eaten primes may have been rerolled into non-primes (and vice versa)
+	if (bPrimesChanged)
+	{
+		RebuildViewportPrimes();
+	}
+
+	// Consumed scary tiles may have been the closest ones
+	if (bScaryConsumed)
+	{
+		RefreshSensorProximity();
 	}
 
 	// ========================================
-	// Step 6: Apply Total Value to Bar
+	// Step 5: Apply Total Value to Bar
 	// ========================================
 	PendingChunkValue = TotalValueFromSnake;
 	ApplChunkToBar(BarIndex);
 
 	// ========================================
-	// Step 7: Refresh UI
+	// Step 6: Refresh UI
 	// ========================================
-	// Force the UI to update to show new numbers
-	OnGridScrolled();
+	// Only the eaten tiles changed - no need for a full grid refresh
+	GridTexels.Flush();
+	if (ViewportDelta.ChangedSlots.Num() > 0)
+	{
+		NotifyViewportDelta();
+
+		// Opt-in for widgets that only redraw on scrolls (costs a full refresh per drop)
+		if (bLegacyDropRefresh)
+		{
+			NotifyGridScrolled();
+		}
+	}
+
+	return TotalValueFromSnake;
 }
 
 /**
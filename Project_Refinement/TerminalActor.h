@@ -2,8 +2,97 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "TerminalGridStore.h"
+#include "TerminalReplication.h"
+#include "TerminalGridTexture.h"
+#include "TerminalEventBus.h"
+#include "TerminalJobScheduler.h"
+#include "TerminalReplay.h"
+#include "TerminalSnakeSearch.h"
 #include "TerminalActor.generated.h"
 
+/**
+ * Broadcast when the proximity sensor crosses one of the terminal's SensorThresholds.
+ *
+ * @param ProximityValue - New sensor value (0.0 = far/none, 1.0 = very close)
+ * @param ThresholdLevel - How many thresholds the value is at or above (0 = calm)
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnSensorProximityChanged, float, ProximityValue, int32, ThresholdLevel);
+
+/**
+ * Broadcast when the next day's grid has finished building in the background.
+ *
+ * @param NextSeed - Seed the prebuilt grid was generated from
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnNextDayPrepared, int32, NextSeed);
+
+/**
+ * Broadcast when an asynchronous snapshot save or load finishes.
+ *
+ * @param SlotName - Save slot that was written or read
+ * @param bSuccess - Whether the operation succeeded
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTerminalSnapshotFinished, const FString&, SlotName, bool, bSuccess);
+
+/**
+ * Broadcast when a replay stops.
+ *
+ * @param RecordsApplied - Records played back into the terminal
+ * @param bCompleted - Whether the recording played to its end (false if stopped or corrupt)
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTerminalReplayFinished, int32, RecordsApplied, bool, bCompleted);
+
+/**
+ * Where HighlightRandomPrime looks for a prime to turn scary.
+ */
+UENUM(BlueprintType)
+enum class ETerminalPrimeScope : uint8
+{
+	/** Only primes currently on screen (the player sees them light up) */
+	Viewport,
+
+	/** Any prime on the whole map (builds up off-screen threats) */
+	WholeMap
+};
+
+/**
+ * Describes which tiles of the visible window changed since the last update.
+ *
+ * The visible window is stored as a ring buffer: scrolling by one tile only
+ * refills the row or column that entered the view, reusing the slots of the
+ * row or column that left. Screen tile (X, Y) lives in slot
+ * ((Y + RingOffsetY) % GridHeight) * GridWidth + (X + RingOffsetX) % GridWidth.
+ */
+USTRUCT(BlueprintType)
+struct FTerminalViewportDelta
+{
+	GENERATED_BODY()
+
+	/** Tiles scrolled along X since the previous delta (0 for in-place tile changes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Viewport")
+	int32 ShiftX = 0;
+
+	/** Tiles scrolled along Y since the previous delta (0 for in-place tile changes) */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Viewport")
+	int32 ShiftY = 0;
+
+	/** True when every slot was refilled (new grid, resize, or a jump larger than the window) */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Viewport")
+	bool bFullRefresh = false;
+
+	/** Ring slots whose tile changed; the old tile left the view and the new one entered */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Viewport")
+	TArray<int32> ChangedSlots;
+
+	/** Current ring offset along X */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Viewport")
+	int32 RingOffsetX = 0;
+
+	/** Current ring offset along Y */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Viewport")
+	int32 RingOffsetY = 0;
+};
+
 /**
  * Terminal Actor - Core gameplay system for the file refinement minigame.
  * 
@@ -31,6 +120,21 @@ public:
 	ATerminalActor();
 
 	virtual void BeginPlay() override;
+
+	/** Unregisters from the terminal manager and releases the grid */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// ========================================
+	// Replication
+	// ========================================
+
+	/** Client: applies one replicated tile change (view refresh is deferred to FlushReplicatedTiles) */
+	void ApplyReplicatedTile(const FTerminalTileDelta& Tile);
+
+	/** Client: refreshes the viewport and sensor once for all tiles applied since the last flush */
+	void FlushReplicatedTiles();
 	
 	/**
 	 * Called when all four progress bars reach 100%.
@@ -63,6 +167,66 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "Interaction")
 	void OnPlayerExit();
 
+	/**
+	 * Player sat down: makes this the active terminal (waking it within the same
+	 * frame), restores the screen widget's full refresh rate, then fires OnPlayerInteract.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void NotifyPlayerInteract();
+
+	/**
+	 * Player stood up: fires OnPlayerExit, then sends the terminal to sleep
+	 * (timers paused, viewport caches dropped, screen widget redrawn rarely).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void NotifyPlayerExit();
+
+	/** Seconds between screen widget redraws while seated (0 = every frame) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Lifecycle", meta = (ClampMin = "0.0"))
+	float ActiveScreenRedrawTime = 0.f;
+
+	/** Seconds between screen widget redraws while nobody is seated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Lifecycle", meta = (ClampMin = "0.0"))
+	float IdleScreenRedrawTime = 1.0f;
+
+	/**
+	 * Player UI shown while seated at this terminal.
+	 * Leave empty to use the player's TerminalWidgetClass.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Lifecycle")
+	TSubclassOf<class UUserWidget> SeatedWidgetClass;
+
+	// ========================================
+	// Dormancy (Terminal Manager)
+	// ========================================
+
+	/**
+	 * True while the player is not using this terminal.
+	 * Dormant terminals have their timers paused and their viewport caches dropped;
+	 * an untouched grid is also released DormantReleaseDelay seconds after falling asleep.
+	 * Managed by UTerminalSubsystem.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Terminal|Lifecycle")
+	bool bDormant = false;
+
+	/** Seconds a terminal stays asleep before its grid is released (0 = release immediately) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Lifecycle", meta = (ClampMin = "0.0"))
+	float DormantReleaseDelay = 5.0f;
+
+	/**
+	 * Puts the terminal to sleep: pauses the difficulty and cooldown timers,
+	 * drops the viewport caches and schedules the grid release. Called by the terminal manager.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Lifecycle")
+	void EnterDormant();
+
+	/**
+	 * Wakes the terminal: restores the grid and viewport if they were released and
+	 * resumes the difficulty timers if a day is in progress and the bar cooldowns. Called by the terminal manager.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Lifecycle")
+	void WakeFromDormant();
+
 	// ========================================
 	// Components
 	// ========================================
@@ -78,19 +242,67 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Terminal UI")
 	class UCameraComponent* TerminalCamera;
 
+	// ========================================
+	// Grid Texture (GPU Screen)
+	// ========================================
+
+	/**
+	 * If true, the visible window plus GridTextureBorder tiles on every side is kept in
+	 * GridTexture, one texel per tile, and bound to the CRT screen material.
+	 * A digit-atlas material can then draw the grid instead of one text widget per tile;
+	 * scrolling only uploads the rows and columns that entered the window.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Screen")
+	bool bUseGridTexture = false;
+
+	/** Tiles kept around the visible window, so sub-tile scrolling never shows stale texels */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Screen", meta = (ClampMin = "1"))
+	int32 GridTextureBorder = 1;
+
+	/** Material slot of CRTMonitor that draws the grid */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Screen", meta = (ClampMin = "0"))
+	int32 ScreenMaterialIndex = 0;
+
+	/** Texture parameter of the screen material that receives GridTexture */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Screen")
+	FName GridTextureParameterName = TEXT("GridData");
+
+	/**
+	 * Vector parameter of the screen material that receives the visible window in texture UVs:
+	 * XY = top-left of the view (ring origin + border + sub-tile scroll), ZW = size of the view.
+	 * The material samples GridData at XY + ScreenUV * ZW with wrap addressing and decodes
+	 * round(Texel * 255): bits 0-3 digit, bit 4 scary, bit 5 prime.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Screen")
+	FName GridWindowParameterName = TEXT("GridWindow");
+
+	/** One texel per tile of the window and its border (created on the first viewport sync) */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, Category = "Terminal|Screen")
+	class UTexture2D* GridTexture = nullptr;
+
+	/** Dynamic instance of the CRT screen material that samples GridTexture */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, Category = "Terminal|Screen")
+	class UMaterialInstanceDynamic* ScreenMaterial = nullptr;
+
 	// ========================================
 	// Grid System (Local/Screen)
 	// ========================================
 	
-	/** Current visible grid numbers (10x10 window into the global map) */
+	/**
+	 * Current visible grid numbers (10x10 window into the global map).
+	 * Stored as a ring buffer - use GetViewportSlotIndex to find a screen tile's slot.
+	 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TArray<int32> GridNumbers;
 
-	/** Indices of prime numbers in the current visible grid (2, 3, 5, 7) */
+	/** Global indices of prime numbers in the current visible grid (2, 3, 5, 7) */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TArray<int32> PrimeIndices;
 
-	/** Which prime numbers are currently highlighted (for visual feedback) */
+	/**
+	 * Which visible tiles are highlighted primes (prime and scary), by ring slot.
+	 * Same layout as GridNumbers.
+	 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	TArray<bool> HighlightedPrimes;
 
@@ -115,8 +327,9 @@ public:
 	// ========================================
 	
 	/**
-	 * Generates the global infinite grid with random numbers.
+	 * Generates the global infinite grid from DaySeed.
 	 * Also spawns "scary" numbers in a sector pattern (one per 50x50 block).
+	 * In Procedural mode no numbers are rolled here; they are computed on demand.
 	 */
 	UFUNCTION(BlueprintCallable)
 	void GenerateGrid();
@@ -131,10 +344,60 @@ public:
 	/**
 	 * Randomly selects and activates one non-scary prime number as scary.
 	 * Used to increase difficulty/tension over time.
+	 * Picks in O(1) from a natively maintained candidate set (see PrimeHighlightScope).
 	 */
 	UFUNCTION(BlueprintCallable)
 	void HighlightRandomPrime();
 
+	/** Where HighlightRandomPrime picks its prime from */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Difficulty")
+	ETerminalPrimeScope PrimeHighlightScope = ETerminalPrimeScope::Viewport;
+
+	// ========================================
+	// Difficulty Schedule
+	// ========================================
+
+	/** If true, StartDay starts the highlight/stress timers and the day's end stops them */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Difficulty")
+	bool bUseDifficultySchedule = true;
+
+	/** Seconds between prime highlights at the start of a day */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Difficulty")
+	float BaseHighlightInterval = 8.0f;
+
+	/** Fastest the highlight timer can get, in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Difficulty")
+	float MinHighlightInterval = 1.5f;
+
+	/** Seconds between difficulty increases */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Difficulty")
+	float StressInterval = 30.0f;
+
+	/** Highlight interval multiplier applied at each difficulty increase (0.85 = 15% faster) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Difficulty")
+	float HighlightIntervalScale = 0.85f;
+
+	/** Current difficulty level (0 at the start of each day) */
+	UPROPERTY(BlueprintReadOnly, Category = "Scary|Difficulty")
+	int32 DifficultyLevel = 0;
+
+	/** Starts (or restarts from level 0) the highlight and stress timers */
+	UFUNCTION(BlueprintCallable, Category = "Scary|Difficulty")
+	void StartDifficultySchedule();
+
+	/** Stops the highlight and stress timers */
+	UFUNCTION(BlueprintCallable, Category = "Scary|Difficulty")
+	void StopDifficultySchedule();
+
+	/**
+	 * Blueprint event called each time the difficulty level goes up.
+	 * 
+	 * @param NewLevel - The new DifficultyLevel
+	 * @param HighlightInterval - Seconds between prime highlights from now on
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Scary|Difficulty")
+	void OnDifficultyIncreased(int32 NewLevel, float HighlightInterval);
+
 	/**
 	 * Checks if a screen-space tile index is currently scary (red).
 	 * 
@@ -144,6 +407,16 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsIndexScary(int32 ScreenIndex) const;
 
+	/**
+	 * Checks if a tile of the global grid is currently scary (red).
+	 * Replaces reading the old ScaryActive array from Blueprint.
+	 * 
+	 * @param GlobalIndex - Row-major index in the global grid (Y * GlobalMapWidth + X)
+	 * @return true if that tile is a scary number, false for out-of-range indices
+	 */
+	UFUNCTION(BlueprintPure)
+	bool IsGlobalIndexScary(int32 GlobalIndex) const;
+
 	/**
 	 * Gets a 3x3 group of indices around a center point.
 	 * Used for group operations or visual effects.
@@ -154,6 +427,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Terminal|Grid")
 	TArray<int32> Get3x3Group(int32 CenterIndex) const;
 
+	/**
+	 * Allocation-free version of Get3x3Group for native callers.
+	 * 
+	 * @param CenterIndex - The center tile index in global coordinates
+	 * @param OutGroup - Receives up to 9 indices (fixed capacity, never allocates)
+	 */
+	void Get3x3GroupInto(int32 CenterIndex, TArray<int32, TFixedAllocator<9>>& OutGroup) const;
+
 	/**
 	 * Gets the number at a specific grid coordinate.
 	 * Handles wrapping for the infinite grid.
@@ -165,13 +446,79 @@ public:
 	UFUNCTION(BlueprintPure)
 	int32 GetGridNumber(int32 GridX, int32 GridY) const;
 
+	/**
+	 * Reads an arbitrary rectangle of the global grid in one call.
+	 * Much cheaper than calling GetGridNumber / IsIndexScary per tile from Blueprint.
+	 * Outputs are row-major, RectWidth x RectHeight.
+	 * 
+	 * @param StartX - Left column (can be any value, wraps automatically)
+	 * @param StartY - Top row (can be any value, wraps automatically)
+	 * @param RectWidth - Columns to read
+	 * @param RectHeight - Rows to read
+	 * @param OutNumbers - Numbers (1-9) per tile
+	 * @param OutScary - Whether each tile is scary
+	 * @param OutPrime - Whether each tile's number is prime
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Terminal|Grid")
+	void FetchGridRect(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight,
+		TArray<int32>& OutNumbers, TArray<bool>& OutScary, TArray<bool>& OutPrime) const;
+
+	/**
+	 * Reads the visible window (GridWidth x GridHeight at ScrollX/ScrollY) in screen order.
+	 * Same outputs as FetchGridRect; index i matches screen index i.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Terminal|Grid")
+	void FetchVisibleGrid(TArray<int32>& OutNumbers, TArray<bool>& OutScary, TArray<bool>& OutPrime) const;
+
 	/**
 	 * Blueprint event called whenever the grid scrolls.
 	 * Use this to update UI, refresh displayed numbers, etc.
+	 * Drops only fire OnViewportDelta, unless bLegacyDropRefresh is set.
 	 */
 	UFUNCTION(BlueprintImplementableEvent, Category = "Terminal|Events")
 	void OnGridScrolled();
 
+	/**
+	 * When true, OnGridScrolled, OnProgressUpdated, OnChunkConsumed and OnFileCompleted
+	 * fire once at the end of the frame with duplicates merged (see UTerminalEventBus).
+	 * When false they fire immediately, as they happen; the bus still gets a copy.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Events")
+	bool bCoalesceEvents = true;
+
+	/**
+	 * When true, drops also fire OnGridScrolled after OnViewportDelta, for widgets
+	 * that still redraw the whole window on scrolls only. Off by default: a full
+	 * refresh per drop is what OnViewportDelta replaces.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Events")
+	bool bLegacyDropRefresh = false;
+
+	/**
+	 * Fires the Blueprint event matching a coalesced bus event.
+	 * Called by UTerminalEventBus when bCoalesceEvents is set.
+	 */
+	void DispatchTerminalEvent(const FTerminalEvent& Event);
+
+	/**
+	 * Blueprint event called when tiles of the visible window change.
+	 * Only the listed slots need to be redrawn; everything else is unchanged.
+	 * 
+	 * @param Delta - Which ring slots changed and the current ring offsets
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Terminal|Events")
+	void OnViewportDelta(const FTerminalViewportDelta& Delta);
+
+	/**
+	 * Converts a screen-space index (0-99) to its slot in the ring-buffered
+	 * GridNumbers / HighlightedPrimes arrays.
+	 * 
+	 * @param ScreenIndex - Index in the visible 10x10 grid
+	 * @return Slot index, or INDEX_NONE if out of range
+	 */
+	UFUNCTION(BlueprintPure, Category = "Terminal|Grid")
+	int32 GetViewportSlotIndex(int32 ScreenIndex) const;
+
 	// ========================================
 	// Progress Bar System
 	// ========================================
@@ -256,6 +603,7 @@ public:
 	/**
 	 * Handles a player "dropping" a snake of numbers onto a progress bar.
 	 * Calculates total value based on number values and scary multipliers.
+	 * Eaten tiles are rerolled and reported through a single OnViewportDelta (see bLegacyDropRefresh).
 	 * 
 	 * @param TileIndices - Screen-space indices of tiles in the snake
 	 * @param BarIndex - Which progress bar to apply the value to
@@ -263,6 +611,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Terminal")
 	void HandleScaryDrop(const TArray<int32>& TileIndices, int32 BarIndex);
 
+	/**
+	 * Native batched drop. Scores a span of screen-space tile indices straight from
+	 * the viewport ring buffer, rerolls them from the terminal's RNG stream and
+	 * emits one OnViewportDelta listing only the changed tiles.
+	 * Indices outside the visible window are ignored, and a drop on a full or
+	 * cooling bar is rejected before any tile is eaten.
+	 * 
+	 * @param TileIndices - Screen-space indices of tiles in the snake
+	 * @param BarIndex - Which progress bar to apply the value to
+	 * @return Total chunk value scored from the snake
+	 */
+	float HandleScaryDropSpan(TConstArrayView<int32> TileIndices, int32 BarIndex);
+
 	/**
 	 * Blueprint event called when a chunk is calculated and ready.
 	 * 
@@ -271,6 +632,85 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Progress")
 	void OnChunkReady(float ChunkValue);
 
+	// ========================================
+	// Snake Hints
+	// ========================================
+
+	/**
+	 * Finds the highest-value snakes in the visible window right away (see FTerminalSnakeSearch).
+	 * A 10x10 window with the default settings takes a few tens of microseconds.
+	 *
+	 * @param Settings - Snake lengths, beam width, result count and border
+	 * @param OutSnakes - Best snakes first
+	 * @return Number of snakes found
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Hints")
+	int32 FindBestSnakes(const FTerminalSnakeSearchSettings& Settings, TArray<FTerminalSnake>& OutSnakes);
+
+	/**
+	 * Starts a snake search to be run in slices with ContinueSnakeSearch.
+	 * Replaces a search in progress.
+	 *
+	 * @return false if the window can't be searched (no grid, or more than 256 tiles with the border)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Hints")
+	bool BeginSnakeSearch(const FTerminalSnakeSearchSettings& Settings);
+
+	/**
+	 * Runs the current snake search for up to BudgetMicroseconds.
+	 * If the grid scrolled or on-screen tiles changed since BeginSnakeSearch the search restarts on the new window.
+	 *
+	 * @param OutSnakes - Best snakes found so far
+	 * @return true once the search is finished
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Hints")
+	bool ContinueSnakeSearch(float BudgetMicroseconds, TArray<FTerminalSnake>& OutSnakes);
+
+	// ========================================
+	// Scary Density
+	// ========================================
+
+	/** Scary tiles in one sector that draw at full intensity in ScaryDensityTexture */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Minimap", meta = (ClampMin = "1"))
+	int32 ScaryDensityFullCount = 2;
+
+	/**
+	 * One texel per map sector (50x50 tiles), brighter where scary tiles are denser.
+	 * Created and refreshed by GetScaryDensityTexture.
+	 */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Transient, Category = "Terminal|Minimap")
+	class UTexture2D* ScaryDensityTexture = nullptr;
+
+	/**
+	 * Counts the scary tiles in every map sector touched by a rectangle of global tiles.
+	 * O(1) through the grid store's summed-area table, so it may include tiles up to
+	 * one sector outside the rectangle.
+	 *
+	 * @param StartX - Left edge in global tiles (wraps automatically)
+	 * @param StartY - Top edge in global tiles (wraps automatically)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Terminal|Minimap")
+	int32 CountScaryInRect(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight) const;
+
+	/**
+	 * Counts the scary tiles in every map sector touched by the square of Radius tiles
+	 * around a global point. O(1), at sector resolution like CountScaryInRect.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Terminal|Minimap")
+	int32 CountScaryInRadius(float CenterX, float CenterY, float Radius) const;
+
+	/** CountScaryInRadius around the center of the screen (the point the sensor measures from) */
+	UFUNCTION(BlueprintPure, Category = "Terminal|Minimap")
+	int32 CountScaryNearView(float Radius) const;
+
+	/**
+	 * Returns ScaryDensityTexture, (re)creating it for the map size and uploading it
+	 * if any scary tile changed since the last call. Cheap to call every frame.
+	 * Returns nullptr before a grid exists.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Minimap")
+	class UTexture2D* GetScaryDensityTexture();
+
 	/**
 	 * Blueprint event called after a chunk is applied to a bar.
 	 * Use this for sound effects, particles, etc.
@@ -286,17 +726,21 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cooldown")
 	TArray<bool> bBarCoolingDown;
 
-	/** Time remaining for each bar's cooldown */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cooldown")
+	/**
+	 * Time remaining for each bar's cooldown, as of the moment it last started or ended.
+	 * Nothing ticks while bars cool down, so this is not counted down per frame.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cooldown", meta = (DeprecatedProperty, DeprecationMessage = "Not counted down per frame anymore - use GetBarCooldownRemaining for the live value"))
 	TArray<float> BarCooldownRemaining;
 
-	/** How long bars stay on cooldown after being filled (seconds) */
+	/** How long bars stay on cooldown after being filled (seconds, 0 disables cooldowns) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cooldown")
 	float BarCooldownSeconds = 2.5f;
 
 	/**
 	 * Gets the cooldown progress for a bar (0.0 = done, 1.0 = just started).
 	 * Use this to display cooldown timer UI.
+	 * Computed from the cooldown start time, so nothing ticks while bars cool down.
 	 * 
 	 * @param BarIndex - Which bar to check (0-3)
 	 * @return Cooldown ratio from 0.0 to 1.0
@@ -304,6 +748,30 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Cooldown")
 	float GetBarCooldownRatio(int32 BarIndex) const;
 
+	/**
+	 * Gets the seconds left on a bar's cooldown.
+	 * 
+	 * @param BarIndex - Which bar to check (0-3)
+	 * @return Remaining cooldown in seconds, 0 if the bar is not cooling down
+	 */
+	UFUNCTION(BlueprintPure, Category = "Cooldown")
+	float GetBarCooldownRemaining(int32 BarIndex) const;
+
+	/**
+	 * Puts a bar on cooldown for BarCooldownSeconds.
+	 * Called automatically when a chunk fills a bar; restarts the cooldown if already cooling.
+	 * 
+	 * @param BarIndex - Which bar (0-3)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Cooldown")
+	void StartBarCooldown(int32 BarIndex);
+
+	/**
+	 * Cancels every running bar cooldown, firing OnBarCooldownEnded for each.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Cooldown")
+	void ClearBarCooldowns();
+
 	/**
 	 * Blueprint event called when a bar enters cooldown.
 	 * 
@@ -330,7 +798,7 @@ public:
 	int32 FilesPerDay = 2;
 
 	/** How many files have been completed in the current day */
-	UPROPERTY(BlueprintReadWrite, Category = "Day")
+	UPROPERTY(Replicated, BlueprintReadWrite, Category = "Day")
 	int32 FilesRefinedCount = 0;
 
 	/** Legacy files completed counter (kept for compatibility) */
@@ -338,16 +806,149 @@ public:
 	int32 FilesCompleted = 0;
 
 	/** Whether a workday is currently active */
-	UPROPERTY(BlueprintReadOnly, Category = "Day")
+	UPROPERTY(Replicated, BlueprintReadOnly, Category = "Day")
 	bool bDayActive = false;
 
 	/**
 	 * Starts a new workday.
-	 * Resets counters, generates new grid, broadcasts event.
+	 * Resets counters, swaps in the prebuilt grid (see PrepareNextDay) or
+	 * generates a new one, broadcasts event.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Day")
 	void StartDay();
 
+	/**
+	 * Starts building the next day's grid on a worker thread.
+	 * StartDay then swaps it in instantly instead of generating on the game thread.
+	 * Called automatically when a day completes if bPrebuildNextDay is set;
+	 * call it earlier (e.g. mid-day) to give the worker more time.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Day")
+	void PrepareNextDay();
+
+	/** Whether a prebuilt grid is finished and ready for StartDay to swap in */
+	UFUNCTION(BlueprintPure, Category = "Day")
+	bool IsNextDayReady() const;
+
+	/** Fired on the game thread when a grid requested by PrepareNextDay is ready */
+	UPROPERTY(BlueprintAssignable, Category = "Day")
+	FOnNextDayPrepared OnNextDayPrepared;
+
+	// ========================================
+	// Save / Restore
+	// ========================================
+
+	/**
+	 * Store only the scary tiles that changed vs the seeded layout in snapshots
+	 * (a few bytes) instead of the full one-bit-per-cell mask (~125 KB on the default map).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Save")
+	bool bDeltaSnapshots = true;
+
+	/**
+	 * Writes a compact binary snapshot of the terminal: seed and map settings,
+	 * eaten tiles, scary changes, progress bars, cooldowns, file count and day timing.
+	 * The grid itself is not stored - it is regenerated from the seed on load.
+	 * 
+	 * @param OutSnapshot - Receives the snapshot bytes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void WriteSnapshot(TArray<uint8>& OutSnapshot) const;
+
+	/**
+	 * Restores a snapshot written by WriteSnapshot (any older snapshot version is accepted).
+	 * On failure the terminal is left untouched.
+	 * 
+	 * @param Snapshot - Snapshot bytes
+	 * @return true if the snapshot was valid and fully applied
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	bool ReadSnapshot(const TArray<uint8>& Snapshot);
+
+	/**
+	 * Snapshots the terminal on the game thread and writes it to a save slot
+	 * in the background. Fires OnSnapshotSaved when done.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void SaveSnapshotAsync(const FString& SlotName, int32 UserIndex = 0);
+
+	/**
+	 * Reads a save slot in the background and restores it on the game thread.
+	 * Fires OnSnapshotLoaded when done.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Save")
+	void LoadSnapshotAsync(const FString& SlotName, int32 UserIndex = 0);
+
+	/** Fired when SaveSnapshotAsync finishes */
+	UPROPERTY(BlueprintAssignable, Category = "Save")
+	FOnTerminalSnapshotFinished OnSnapshotSaved;
+
+	/** Fired when LoadSnapshotAsync finishes */
+	UPROPERTY(BlueprintAssignable, Category = "Save")
+	FOnTerminalSnapshotFinished OnSnapshotLoaded;
+
+	// ========================================
+	// Record / Replay
+	// ========================================
+
+	/**
+	 * Starts recording the session: the current state, then every trackball move,
+	 * drop, chunk, day start and timer the terminal reacts to (see FTerminalRecorder).
+	 * Restarts an active recording. Not available while a replay runs.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	void StartRecording();
+
+	/**
+	 * Stops recording and returns the stream.
+	 *
+	 * @return false if nothing was being recorded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	bool StopRecording(TArray<uint8>& OutRecording);
+
+	/** Stops recording and writes the stream to a file */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	bool StopRecordingToFile(const FString& FilePath);
+
+	UFUNCTION(BlueprintPure, Category = "Replay")
+	bool IsRecording() const { return Recorder.IsValid(); }
+
+	/**
+	 * Restores a recording's starting state and plays it back.
+	 * While replaying, the terminal's own difficulty and cooldown timers are off
+	 * (they come from the recording) and player input should not be forwarded to it.
+	 *
+	 * @param Recording - Bytes from StopRecording
+	 * @param bRealTime - Play at recorded speed; if false the whole recording is applied before this returns
+	 * @return false if the recording could not be loaded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	bool StartReplay(const TArray<uint8>& Recording, bool bRealTime = false);
+
+	/** StartReplay with a recording read from a file */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	bool StartReplayFromFile(const FString& FilePath, bool bRealTime = false);
+
+	/** Stops a running replay; the terminal keeps the state reached and resumes its timers */
+	UFUNCTION(BlueprintCallable, Category = "Replay")
+	void StopReplay();
+
+	UFUNCTION(BlueprintPure, Category = "Replay")
+	bool IsReplaying() const { return Replayer.IsValid(); }
+
+	/** Records applied by the last finished replay */
+	UFUNCTION(BlueprintPure, Category = "Replay")
+	int32 GetLastReplayRecordCount() const { return LastReplayRecordCount; }
+
+	/** Fired when a replay completes or is stopped */
+	UPROPERTY(BlueprintAssignable, Category = "Replay")
+	FOnTerminalReplayFinished OnReplayFinished;
+
+	/** If true, the next day's grid starts building in the background as soon as a day completes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Day")
+	bool bPrebuildNextDay = true;
+
 	/**
 	 * Ends the current workday.
 	 * Sets bDayActive to false, broadcasts completion event.
@@ -404,27 +1005,53 @@ public:
 	// Scary Number System
 	// ========================================
 	
-	/**
-	 * Tracks which tiles in the global grid are currently "scary" (red).
-	 * Scary numbers provide 4x progress bonus when consumed.
-	 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Scary")
-	TArray<bool> ScaryActive;
-
 	/**
 	 * Gets the proximity sensor value (0.0 = far, 1.0 = very close).
 	 * Indicates how close the nearest scary number is to the player's view.
 	 * Use this to drive anxiety/stress UI, sound effects, screen shake, etc.
 	 * 
+	 * The value is cached and only recomputed when the view moves or scary tiles
+	 * change, so reading it every frame is free. Prefer binding to
+	 * OnSensorProximityChanged over polling.
+	 * 
 	 * @return Distance ratio from 0.0 (far/none) to 1.0 (very close)
 	 */
 	UFUNCTION(BlueprintPure, Category = "Scary|Sensor")
-	float GetSensorProximityValue() const;
+	float GetSensorProximityValue() const { return CachedSensorProximity; }
+
+	/**
+	 * Gets how many SensorThresholds the current proximity value is at or above.
+	 * 0 means calm; SensorThresholds.Num() means the highest stress level.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Scary|Sensor")
+	int32 GetSensorThresholdLevel() const { return SensorThresholdLevel; }
+
+	/**
+	 * Recomputes the cached proximity value and broadcasts OnSensorProximityChanged
+	 * if it crossed a threshold. Called automatically whenever the view or the scary
+	 * set changes; only call this manually after editing ScrollX/ScrollY directly.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Scary|Sensor")
+	void RefreshSensorProximity();
 
 	/** Maximum distance (in tiles) for scary number detection */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Sensor")
 	float MaxSensorDistance = 20.0f;
 
+	/**
+	 * Proximity values (ascending, 0.0 to 1.0) that trigger OnSensorProximityChanged
+	 * when crossed in either direction.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Scary|Sensor")
+	TArray<float> SensorThresholds;
+
+	/**
+	 * Fired when the proximity value crosses one of SensorThresholds.
+	 * Bind stress UI, audio and camera shake here instead of polling every frame.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Scary|Sensor")
+	FOnSensorProximityChanged OnSensorProximityChanged;
+
 	/**
 	 * Blueprint event called when a group of tiles is cleared.
 	 * 
@@ -437,9 +1064,12 @@ public:
 	// Infinite Grid / Scrolling System
 	// ========================================
 	
-	/** The complete infinite grid of numbers (1000x1000 by default) */
-	UPROPERTY()
-	TArray<int32> GlobalGridNumbers;
+	/**
+	 * The complete infinite grid (1000x1000 by default).
+	 * Holds the numbers (1-9) and which tiles are currently "scary" (red).
+	 * Scary numbers provide 4x progress bonus when consumed.
+	 */
+	FTerminalGridStore GridStore;
 
 	/** Width of the global grid (creates wrapping/pac-man effect) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite")
@@ -449,6 +1079,47 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite")
 	int32 GlobalMapHeight = 1000;
 
+	/**
+	 * If true, GenerateGrid rounds GlobalMapWidth/GlobalMapHeight up to powers of two
+	 * (1000 -> 1024) so every coordinate wrap is a bit mask instead of a division.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite")
+	bool bPowerOfTwoMap = false;
+
+	/**
+	 * How grid numbers are produced.
+	 * Procedural computes each cell from (DaySeed, x, y) on demand, so generating
+	 * a day is nearly free and only eaten tiles take memory.
+	 * Eager rolls and stores every cell up front.
+	 * Streamed also drops the per-cell scary mask and caches 50x50 sectors around
+	 * the view instead, for maps of 10k x 10k and larger.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite")
+	ETerminalGridMode GridMode = ETerminalGridMode::Procedural;
+
+	/**
+	 * Memory budget for the sectors a Streamed grid keeps resident, in KB.
+	 * The least recently viewed sectors are evicted beyond it (~2.5 KB per sector).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite", meta = (ClampMin = "1"))
+	int32 StreamingBudgetKB = 1024;
+
+	/**
+	 * Streamed mode: rings of sectors around the view that are materialized in the
+	 * background after a grid is built or the terminal wakes (0 = only the view).
+	 * Keep (2 * Radius + 2)^2 sectors within StreamingBudgetKB.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite", meta = (ClampMin = "0"))
+	int32 WarmupSectorRadius = 1;
+
+	/** Seed for the current day's grid (numbers and scary placement) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite")
+	int32 DaySeed = 0;
+
+	/** If true, a fresh DaySeed is picked at BeginPlay and at every StartDay */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Infinite")
+	bool bRandomizeDaySeed = true;
+
 	/** Current horizontal scroll position in the global grid */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Terminal|Infinite")
 	int32 ScrollX = 0;
@@ -470,8 +1141,9 @@ public:
 	float AccumulatorY;
 
 	/**
-	 * Applies mouse/trackball movement to scroll the grid.
+	 * Applies mouse/trackball movement to scroll the grid immediately.
 	 * Handles sub-pixel accumulation and wrapping.
+	 * OnGridScrolled only fires if the integer scroll position actually changed.
 	 * 
 	 * @param AxisX - Horizontal input (-1.0 to 1.0)
 	 * @param AxisY - Vertical input (-1.0 to 1.0)
@@ -502,17 +1174,369 @@ protected:
 	float DayStartTime;
 
 private:
+	friend class FTerminalRecorder;
+	friend class FTerminalReplayer;
+
 	/** Timer for periodic prime highlighting */
 	FTimerHandle HighlightTimerHandle;
 	
 	/** Timer for stress/difficulty increases */
 	FTimerHandle StressTimerHandle;
 
+	/** One timer per bar; the timer manager fires EndBarCooldown when it expires */
+	TArray<FTimerHandle> BarCooldownTimers;
+
+	/** World time each bar's cooldown started (only meaningful while cooling) */
+	TArray<float> BarCooldownStartTimes;
+
+	/** Full length of each bar's running cooldown, for the ratio (0 when not cooling) */
+	TArray<float> BarCooldownDurations;
+
+	/** Set while the terminal sleeps; cooldown timers are paused and their clock is stopped */
+	bool bBarCooldownsPaused = false;
+
+	/** World time the cooldowns were paused at */
+	float BarCooldownPauseTime = 0.f;
+
+	/** Pauses every cooldown timer (the terminal fell asleep) */
+	void PauseBarCooldowns();
+
+	/** Resumes the cooldown timers where they were paused */
+	void UnpauseBarCooldowns();
+
+	/** Time the cooldown start times are measured against (stops while paused) */
+	float GetBarCooldownClock() const;
+
+	/** Makes the bar available again */
+	void EndBarCooldown(int32 BarIndex);
+
+	/** Cooldown timer callback - records the timer, then EndBarCooldown */
+	void HandleBarCooldownTimer(int32 BarIndex);
+
+	/**
+	 * Per-terminal RNG for tile rerolls and highlight picks.
+	 * Reseeded from DaySeed whenever the grid is rebuilt, so a day plays out
+	 * the same for the same seed and inputs.
+	 */
+	FRandomStream GridRandomStream;
+
+	// ========================================
+	// Replicated State (server -> clients)
+	// ========================================
+
+	/** Seed and map settings; clients generate the grid themselves */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedGrid)
+	FTerminalReplicatedGrid ReplicatedGrid;
+
+	/** Tiles that differ from the seeded grid */
+	UPROPERTY(Replicated)
+	FTerminalTileDeltaArray TileDeltas;
+
+	/** Quantized scroll position */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedView)
+	FTerminalReplicatedView ReplicatedView;
+
+	/** Compact progress bars and cooldowns */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedBars)
+	FTerminalReplicatedBars ReplicatedBars;
+
+	/** Client: tiles applied since the last FlushReplicatedTiles */
+	TArray<int32> PendingReplicatedTiles;
+
+	UFUNCTION()
+	void OnRep_ReplicatedGrid();
+
+	UFUNCTION()
+	void OnRep_ReplicatedView();
+
+	UFUNCTION()
+	void OnRep_ReplicatedBars();
+
+	/** Whether this instance should publish its state (server in a networked game) */
+	bool IsPublishingState() const;
+
+	/** Server: publishes grid settings and rebuilds the tile delta list for the current grid */
+	void PublishGrid();
+
+	/** Server: publishes one tile's current state */
+	void PublishTile(int32 GlobalIndex);
+
+	/** Server: publishes the scroll position */
+	void PublishView();
+
+	/** Server: publishes progress bars and cooldowns */
+	void PublishBars();
+
+	/** Current seconds between highlights (shrinks as DifficultyLevel rises) */
+	float CurrentHighlightInterval = 0.f;
+
+	/** Starts the highlight and stress timers at the current interval */
+	void ArmDifficultyTimers();
+
+	/** Restores a bar cooldown of Duration seconds that has already run for Elapsed seconds */
+	void ResumeBarCooldown(int32 BarIndex, float Duration, float Elapsed);
+
+	/** Async save callback */
+	void HandleSnapshotSaved(const FString& SlotName, const int32 UserIndex, bool bSuccess);
+
+	/** Async load callback */
+	void HandleSnapshotLoaded(const FString& SlotName, const int32 UserIndex, class USaveGame* SaveGame);
+
+	/** Timer for the delayed release of a dormant terminal's buffers */
+	FTimerHandle DormantReleaseTimerHandle;
+
+	/** Frees the grid of a sleeping terminal if untouched (it can be re-acquired from the cache) */
+	void ReleaseDormantBuffers();
+
+	/** Frees the viewport ring and any Streamed sectors; SyncViewport rebuilds them */
+	void ReleaseViewportCaches();
+
+	/** Sets the redraw interval of the screen widget(s) on the terminal */
+	void SetScreenRedrawTime(float RedrawTime);
+
+	/** Highlight timer callback */
+	void HandleHighlightTimer();
+
+	/** Stress timer callback - raises DifficultyLevel and speeds up highlights */
+	void HandleStressTimer();
+
+	// ========================================
+	// Snake Hints
+	// ========================================
+
+	/** Search engine, reused so searches don't allocate once warmed up */
+	FTerminalSnakeSearch SnakeSearch;
+
+	/** Settings and scroll position of the current search */
+	FTerminalSnakeSearchSettings SnakeSearchSettings;
+	int32 SnakeSearchScrollX = 0;
+	int32 SnakeSearchScrollY = 0;
+
+	/** Set when on-screen tiles changed since BeginSnakeSearch; the next slice restarts the search */
+	bool bSnakeSearchStale = false;
+
+	/** Window read for the search (kept to reuse the allocations) */
+	TArray<int32> SnakeSearchNumbers;
+	TArray<bool> SnakeSearchScary;
+	TArray<bool> SnakeSearchPrime;
+
+	/** Cells of one result, reused by GetSnakeSearchResults */
+	TArray<int32> SnakeSearchCells;
+
+	/** Converts the search results into screen-space snakes */
+	void GetSnakeSearchResults(TArray<FTerminalSnake>& OutSnakes);
+
+	// ========================================
+	// Scary Density
+	// ========================================
+
+	/** Density table revision last uploaded to ScaryDensityTexture (0 = never) */
+	uint32 ScaryDensityTextureRevision = 0;
+
+	// ========================================
+	// Record / Replay
+	// ========================================
+
+	/** Active recording, or null */
+	TUniquePtr<FTerminalRecorder> Recorder;
+
+	/** Active replay, or null */
+	TUniquePtr<FTerminalReplayer> Replayer;
+
+	/** Set while a replay drives the terminal: difficulty and cooldown timers are not armed */
+	bool bReplayClock = false;
+
+	/** Set while Replayer->Advance runs, so StopReplay from a callback waits until it returns */
+	bool bAdvancingReplay = false;
+
+	/** StopReplay was called during Advance */
+	bool bReplayStopRequested = false;
+
+	/** World time a real-time replay started */
+	double ReplayStartTime = 0.0;
+
+	/** Next-tick timer of a real-time replay */
+	FTimerHandle ReplayTimerHandle;
+
+	/** See GetLastReplayRecordCount */
+	int32 LastReplayRecordCount = 0;
+
+	/** Real-time replay step, re-armed every tick */
+	void TickReplay();
+
+	/** Applies records up to a playback time and finishes the replay when done or stopped */
+	void AdvanceReplay(double PlaybackSeconds);
+
+	/** Drops the replayer, resumes the live timers and fires OnReplayFinished */
+	void FinishReplay();
+
+	/** Re-arms the difficulty and cooldown timers after a replay (or a failed start) */
+	void ResumeLiveTimers();
+
+	// ========================================
+	// Grid Rebuild / Next Day Prebuild
+	// ========================================
+
+	/** Applies bPowerOfTwoMap to GlobalMapWidth/GlobalMapHeight */
+	void ResolveMapDimensions();
+
+	/** Refreshes sensor and viewport after GridStore was regenerated or swapped */
+	void OnGridRebuilt();
+
+	/** Grid for the next day, set once the worker job has built it */
+	TSharedPtr<FTerminalGridStore, ESPMode::ThreadSafe> NextDayGrid;
+
+	/** Scheduler job building NextDayGrid */
+	FTerminalJobHandle NextDayJob;
+
+	/** Drops the prebuilt grid and cancels a build still in flight */
+	void ResetNextDay();
+
+	/** Settings the prebuilt grid was requested with; a mismatch makes StartDay rebuild */
+	int32 NextDaySeed = 0;
+	int32 NextDayWidth = 0;
+	int32 NextDayHeight = 0;
+	ETerminalGridMode NextDayMode = ETerminalGridMode::Procedural;
+
+	// ========================================
+	// Viewport Ring Buffer
+	// ========================================
+
+	/** Scroll position the ring buffer currently represents */
+	int32 ViewportScrollX = 0;
+	int32 ViewportScrollY = 0;
+
+	/** Ring offsets (see FTerminalViewportDelta) */
+	int32 ViewportRingX = 0;
+	int32 ViewportRingY = 0;
+
+	/** False until the ring has been filled for the current grid */
+	bool bViewportValid = false;
+
+	/** Reused to avoid allocating a new delta on every scroll */
+	FTerminalViewportDelta ViewportDelta;
+
+	/**
+	 * Brings the ring buffer in line with ScrollX/ScrollY, refilling only the rows
+	 * and columns that entered the view, then fires OnViewportDelta.
+	 * 
+	 * @param bForceFullRefresh - Refill every slot (e.g. after the grid was regenerated)
+	 */
+	void SyncViewport(bool bForceFullRefresh);
+
+	/** Raises OnViewportDelta with ViewportDelta and marks the snake search stale */
+	void NotifyViewportDelta();
+
+	/** Raises OnGridScrolled and counts the broadcast for `stat Terminal` */
+	void NotifyGridScrolled();
+
+	/** Raises OnProgressUpdated through the event bus (or directly, see bCoalesceEvents) */
+	void NotifyProgressUpdated(int32 BarIndex, float NewValue);
+
+	/** Raises OnChunkConsumed through the event bus */
+	void NotifyChunkConsumed();
+
+	/** Raises OnFileCompleted through the event bus */
+	void NotifyFileCompleted();
+
+	/** This world's event bus, or nullptr (e.g. outside a game world) */
+	UTerminalEventBus* GetEventBus() const;
+
+	// ========================================
+	// Scheduled Jobs
+	// ========================================
+
+	/** Streamed sector warm-up around the view (see WarmupSectorRadius) */
+	FTerminalJobHandle WarmupJob;
+
+	/** Change map compaction queued when the terminal falls asleep */
+	FTerminalJobHandle CompactJob;
+
+	/** This world's job scheduler, or nullptr (e.g. outside a game world) */
+	UTerminalJobScheduler* GetJobScheduler() const;
+
+	/** Replaces the warm-up job with one for the current view; does nothing outside Streamed mode or while dormant */
+	void QueueSectorWarmup();
+
+	// ========================================
+	// Grid Texture
+	// ========================================
+
+	/** CPU side of GridTexture (ring-buffered texels and pending upload regions) */
+	FTerminalGridTexture GridTexels;
+
+	/** Wrapped global tile at window position (0, 0) of GridTexels, as of the last sync */
+	int32 GridTextureScrollX = 0;
+	int32 GridTextureScrollY = 0;
+
+	/** (Re)creates GridTexture for the current window size and binds it to the screen material */
+	void InitGridTexture();
+
+	/**
+	 * Brings GridTexels in line with ScrollX/ScrollY, rewriting only the rows and
+	 * columns that entered the window, then uploads. Called by SyncViewport.
+	 */
+	void SyncGridTexture(bool bForceFullRefresh);
+
+	/** Writes a rectangle of window texels from the grid store, starting at global (OriginX, OriginY) for window (0, 0) */
+	void WriteGridTextureRect(int32 OriginX, int32 OriginY, int32 WindowX, int32 WindowY, int32 RectWidth, int32 RectHeight);
+
+	/** Re-reads one global tile into GridTexels if it lies in the window (uploaded by the next GridTexels.Flush) */
+	void UpdateGridTextureTile(int32 GlobalIndex);
+
+	/** Pushes the ring origin and sub-tile scroll to the screen material */
+	void UpdateGridTextureWindow();
+
+	/**
+	 * Re-reads one global tile into the ring buffer if it is visible.
+	 * 
+	 * @return The refreshed slot, or INDEX_NONE if the tile is off screen
+	 */
+	int32 RefreshViewportTile(int32 GlobalIndex);
+
+	/** Ring slot of a screen tile */
+	int32 GetViewportSlot(int32 ScreenX, int32 ScreenY) const
+	{
+		return ((ScreenY + ViewportRingY) % GridHeight) * GridWidth + (ScreenX + ViewportRingX) % GridWidth;
+	}
+
+	/** Fills a ring slot from the global tile at the given (unwrapped) coordinates, read through a VisitTiles reader */
+	template<typename ReaderType>
+	void FillViewportSlot(const ReaderType& Tiles, int32 Slot, int32 GlobalX, int32 GlobalY);
+
+	/** Rebuilds PrimeIndices from the ring buffer */
+	void RebuildViewportPrimes();
+
+	// ========================================
+	// Prime Highlight Candidates
+	// ========================================
+
+	/** Global index shown in each ring slot (INDEX_NONE until filled) */
+	TArray<int32> ViewportSlotGlobal;
+
+	/** Ring slots holding a visible, non-scary prime (dense, unordered) */
+	TArray<int32> PrimeCandidateSlots;
+
+	/** Position of each ring slot in PrimeCandidateSlots, or INDEX_NONE */
+	TArray<int32> PrimeCandidatePos;
+
+	/** Adds or removes a ring slot from the candidate set in O(1) */
+	void SetPrimeCandidate(int32 Slot, bool bCandidate);
+
+	/** Picks a random non-scary prime on the whole map, or INDEX_NONE */
+	int32 PickRandomMapPrime();
+
+	/** Last computed proximity sensor value (see RefreshSensorProximity) */
+	float CachedSensorProximity = 0.f;
+
+	/** Number of SensorThresholds at or below CachedSensorProximity */
+	int32 SensorThresholdLevel = 0;
+
 	/**
 	 * Helper function to find distance to the nearest scary number.
-	 * Used by GetSensorProximityValue.
+	 * Used by RefreshSensorProximity.
 	 * 
-	 * @return Distance in tiles to nearest scary number
+	 * @return Distance in tiles to nearest scary number (MaxSensorDistance if none in range)
 	 */
 	float GetDistanceToNearestScary() const;
 
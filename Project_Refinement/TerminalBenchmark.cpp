@@ -0,0 +1,645 @@
+#include "TerminalBenchmark.h"
+#include "Project_Refinement.h"
+#include "TerminalActor.h"
+#include "TerminalJobScheduler.h"
+#include "TerminalSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include <atomic>
+
+namespace TerminalBenchmark
+{
+	/**
+	 * Passes every call on to the real allocator and counts allocations on the way.
+	 * Only the measuring thread is counted: allocations of other threads (task graph,
+	 * thread pool, the parallel Eager fill itself) are timed but not attributed.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FMalloc* Inner = nullptr;
+		std::atomic<uint32> CountedThreadId{ 0 };
+		std::atomic<uint64> AllocCount{ 0 };
+		std::atomic<uint64> AllocBytes{ 0 };
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment = DEFAULT_ALIGNMENT) override
+		{
+			Record(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment = DEFAULT_ALIGNMENT) override
+		{
+			// A shrink to zero is a free, anything else hands out (possibly new) memory
+			if (Count > 0)
+			{
+				Record(Count);
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("TerminalBenchmarkCounter"); }
+
+	private:
+		void Record(SIZE_T Count)
+		{
+			if (FPlatformTLS::GetCurrentThreadId() != CountedThreadId.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+			AllocCount.fetch_add(1, std::memory_order_relaxed);
+			AllocBytes.fetch_add(Count, std::memory_order_relaxed);
+		}
+	};
+
+	/**
+	 * The proxy is never destroyed: a thread that read GMalloc just before it was
+	 * swapped back may still call into it.
+	 */
+	static FCountingMalloc& GetCountingMalloc()
+	{
+		static FCountingMalloc CountingMalloc;
+		return CountingMalloc;
+	}
+
+	/** Results of timed loops land here so the optimizer can't drop them */
+	static volatile int64 GSink = 0;
+
+	/** Sums one operation over every terminal of a configuration */
+	struct FAccumulator
+	{
+		/** Queued terminal jobs are flushed before each timed loop (may be null) */
+		explicit FAccumulator(UWorld* World)
+			: Scheduler(World ? World->GetSubsystem<UTerminalJobScheduler>() : nullptr)
+		{
+		}
+
+		UTerminalJobScheduler* Scheduler = nullptr;
+		int64 Ops = 0;
+		uint64 Cycles = 0;
+		uint64 Allocs = 0;
+		uint64 Bytes = 0;
+
+		/**
+		 * Times Body (which performs Ops operations) with allocation counting on.
+		 * Only the body runs with the counting allocator installed, and no scheduler
+		 * worker is in flight while GMalloc is swapped.
+		 */
+		template<typename FuncType>
+		void Measure(int64 InOps, FuncType&& Body)
+		{
+			// Work left over from earlier loops would run (and allocate) inside this one
+			if (Scheduler)
+			{
+				Scheduler->FlushJobs();
+			}
+
+			FCountingMalloc& Counter = GetCountingMalloc();
+			Counter.Inner = GMalloc;
+			Counter.CountedThreadId = FPlatformTLS::GetCurrentThreadId();
+			Counter.AllocCount = 0;
+			Counter.AllocBytes = 0;
+
+			GMalloc = &Counter;
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+
+			Body();
+
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+			GMalloc = Counter.Inner;
+
+			Ops += InOps;
+			Cycles += EndCycles - StartCycles;
+			Allocs += Counter.AllocCount;
+			Bytes += Counter.AllocBytes;
+		}
+
+		/** Converts the totals into a per-operation result */
+		void Finish(const TCHAR* Operation, FIntPoint MapSize, ETerminalGridMode Mode, int32 TerminalCount, TArray<FTerminalBenchmarkResult>& OutResults) const
+		{
+			FTerminalBenchmarkResult& Result = OutResults.AddDefaulted_GetRef();
+			Result.Operation = Operation;
+			Result.MapSize = MapSize;
+			Result.Mode = Mode;
+			Result.TerminalCount = TerminalCount;
+			Result.Ops = Ops;
+
+			if (Ops > 0)
+			{
+				Result.NsPerOp = FPlatformTime::ToSeconds64(Cycles) * 1e9 / Ops;
+				Result.AllocsPerOp = (double)Allocs / Ops;
+				Result.BytesPerOp = (double)Bytes / Ops;
+			}
+		}
+	};
+
+	/** Short enum name for logs and CSV ("Procedural") */
+	static FString GetModeName(ETerminalGridMode Mode)
+	{
+		return StaticEnum<ETerminalGridMode>()->GetNameStringByValue((int64)Mode);
+	}
+
+	/** Splits a comma separated command line value */
+	static TArray<FString> SplitList(const FString& Value)
+	{
+		TArray<FString> Entries;
+		Value.ParseIntoArray(Entries, TEXT(","));
+		return Entries;
+	}
+}
+
+// ========================================
+// SETTINGS
+// ========================================
+
+/**
+ * Overrides only the settings present on the command line.
+ */
+bool FTerminalBenchmarkSettings::ParseCommandLine(const TCHAR* CommandLine)
+{
+	FString Value;
+
+	if (FParse::Value(CommandLine, TEXT("Sizes="), Value, false))
+	{
+		MapSizes.Reset();
+		for (const FString& Entry : TerminalBenchmark::SplitList(Value))
+		{
+			FString WidthString;
+			FString HeightString;
+			if (!Entry.Split(TEXT("x"), &WidthString, &HeightString) || !WidthString.IsNumeric() || !HeightString.IsNumeric())
+			{
+				UE_LOG(LogTerminal, Error, TEXT("Benchmark: bad map size '%s' (expected WxH)"), *Entry);
+				return false;
+			}
+			MapSizes.Add(FIntPoint(FCString::Atoi(*WidthString), FCString::Atoi(*HeightString)));
+		}
+	}
+
+	if (FParse::Value(CommandLine, TEXT("Modes="), Value, false))
+	{
+		Modes.Reset();
+		for (const FString& Entry : TerminalBenchmark::SplitList(Value))
+		{
+			const int64 ModeValue = StaticEnum<ETerminalGridMode>()->GetValueByNameString(Entry);
+			if (ModeValue == INDEX_NONE)
+			{
+				UE_LOG(LogTerminal, Error, TEXT("Benchmark: unknown grid mode '%s'"), *Entry);
+				return false;
+			}
+			Modes.Add((ETerminalGridMode)ModeValue);
+		}
+	}
+
+	if (FParse::Value(CommandLine, TEXT("Terminals="), Value, false))
+	{
+		TerminalCounts.Reset();
+		for (const FString& Entry : TerminalBenchmark::SplitList(Value))
+		{
+			if (!Entry.IsNumeric())
+			{
+				UE_LOG(LogTerminal, Error, TEXT("Benchmark: bad terminal count '%s'"), *Entry);
+				return false;
+			}
+			TerminalCounts.Add(FCString::Atoi(*Entry));
+		}
+	}
+
+	FParse::Value(CommandLine, TEXT("Iterations="), Iterations);
+	FParse::Value(CommandLine, TEXT("Generate="), GenerateIterations);
+	FParse::Value(CommandLine, TEXT("Seed="), Seed);
+	FParse::Value(CommandLine, TEXT("Replay="), ReplayPath);
+
+	const bool bValid = MapSizes.Num() > 0 && Modes.Num() > 0 && TerminalCounts.Num() > 0
+		&& !MapSizes.ContainsByPredicate([](const FIntPoint& Size) { return Size.X <= 0 || Size.Y <= 0; })
+		&& !TerminalCounts.ContainsByPredicate([](int32 Count) { return Count <= 0; })
+		&& Iterations > 0 && GenerateIterations > 0;
+
+	if (!bValid)
+	{
+		UE_LOG(LogTerminal, Error, TEXT("Benchmark: sizes, modes and terminal counts must be non-empty and positive"));
+	}
+	return bValid;
+}
+
+// ========================================
+// RUNNER
+// ========================================
+
+/**
+ * Runs every configuration, keeping the player's terminal selection intact.
+ */
+void FTerminalBenchmark::Run(UWorld* World, const FTerminalBenchmarkSettings& Settings, TArray<FTerminalBenchmarkResult>& OutResults)
+{
+	OutResults.Reset();
+
+	if (!World)
+	{
+		return;
+	}
+
+	UTerminalSubsystem* TerminalManager = World->GetSubsystem<UTerminalSubsystem>();
+	ATerminalActor* PreviousActive = TerminalManager ? TerminalManager->GetActiveTerminal() : nullptr;
+
+	for (const FIntPoint& MapSize : Settings.MapSizes)
+	{
+		for (const ETerminalGridMode Mode : Settings.Modes)
+		{
+			for (const int32 TerminalCount : Settings.TerminalCounts)
+			{
+				UE_LOG(LogTerminal, Display, TEXT("Benchmark: %dx%d %s, %d terminal(s)"),
+					MapSize.X, MapSize.Y, *TerminalBenchmark::GetModeName(Mode), TerminalCount);
+
+				RunConfiguration(World, Settings, MapSize, Mode, TerminalCount, OutResults);
+			}
+		}
+	}
+
+	if (!Settings.ReplayPath.IsEmpty())
+	{
+		RunReplay(World, Settings, OutResults);
+	}
+
+	if (TerminalManager)
+	{
+		TerminalManager->SetActiveTerminal(PreviousActive);
+	}
+}
+
+/**
+ * Spawns the terminals, runs the scripted workload on each and destroys them.
+ *
+ * Each terminal is made the active one before its loops run (untimed), the way a
+ * player sits down at it, so the dormant/active lifecycle behaves as in game.
+ */
+void FTerminalBenchmark::RunConfiguration(UWorld* World, const FTerminalBenchmarkSettings& Settings,
+	FIntPoint MapSize, ETerminalGridMode Mode, int32 TerminalCount, TArray<FTerminalBenchmarkResult>& OutResults)
+{
+	using namespace TerminalBenchmark;
+
+	UTerminalSubsystem* TerminalManager = World->GetSubsystem<UTerminalSubsystem>();
+
+	// ========================================
+	// Step 1: Spawn Terminals
+	// ========================================
+	TArray<ATerminalActor*> Terminals;
+	for (int32 i = 0; i < TerminalCount; ++i)
+	{
+		const FTransform SpawnTransform(FVector(i * 500.f, 0.f, -100000.f));
+		ATerminalActor* Terminal = World->SpawnActorDeferred<ATerminalActor>(ATerminalActor::StaticClass(), SpawnTransform);
+		if (!Terminal)
+		{
+			continue;
+		}
+
+		Terminal->GlobalMapWidth = MapSize.X;
+		Terminal->GlobalMapHeight = MapSize.Y;
+		Terminal->GridMode = Mode;
+		Terminal->DaySeed = Settings.Seed;
+		Terminal->bRandomizeDaySeed = false;
+		Terminal->FinishSpawning(SpawnTransform);
+
+		// A bare commandlet world may not dispatch BeginPlay itself
+		if (!Terminal->HasActorBegunPlay())
+		{
+			Terminal->DispatchBeginPlay();
+		}
+		Terminals.Add(Terminal);
+	}
+
+	// ========================================
+	// Step 2: GenerateGrid
+	// ========================================
+	// Every pass uses a new seed for all terminals, so the first build is cold
+	// and the others measure sharing through the terminal manager
+	FAccumulator Generate(World);
+	for (int32 Pass = 0; Pass < Settings.GenerateIterations; ++Pass)
+	{
+		for (ATerminalActor* Terminal : Terminals)
+		{
+			Terminal->DaySeed = Settings.Seed + 1 + Pass;
+			Generate.Measure(1, [Terminal]() { Terminal->GenerateGrid(); });
+		}
+
+		if (TerminalManager)
+		{
+			TerminalManager->TrimGridCache();
+		}
+	}
+	Generate.Finish(TEXT("GenerateGrid"), MapSize, Mode, TerminalCount, OutResults);
+
+	// ========================================
+	// Step 3: Per-Frame Workloads
+	// ========================================
+	FAccumulator Numbers(World);
+	FAccumulator Scroll(World);
+	FAccumulator Sensor(World);
+	FAccumulator Drop(World);
+	FAccumulator Snakes(World);
+	FAccumulator Density(World);
+
+	for (ATerminalActor* Terminal : Terminals)
+	{
+		if (TerminalManager)
+		{
+			TerminalManager->SetActiveTerminal(Terminal);
+		}
+
+		// Same script on every terminal, so configurations are comparable
+		FRandomStream Script(Settings.Seed);
+		const int32 Iterations = Settings.Iterations;
+
+		// Random reads across the whole map (worst case for any cache)
+		Numbers.Measure(Iterations, [Terminal, &Script, Iterations, MapSize]()
+		{
+			int64 Sum = 0;
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Sum += Terminal->GetGridNumber(Script.RandRange(0, MapSize.X - 1), Script.RandRange(0, MapSize.Y - 1));
+			}
+			GSink = GSink + Sum;
+		});
+
+		// Trackball wiggle with a steady drift, so the view keeps crossing tiles and sectors
+		Scroll.Measure(Iterations, [Terminal, &Script, Iterations]()
+		{
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Terminal->ApplyTrackballInput(Script.FRandRange(-1.f, 1.f) + 0.5f, Script.FRandRange(-1.f, 1.f) + 0.25f);
+			}
+		});
+
+		// The sensor query as the HUD would drive it after each move
+		Sensor.Measure(Iterations, [Terminal, Iterations]()
+		{
+			float Sum = 0.f;
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Terminal->RefreshSensorProximity();
+				Sum += Terminal->GetSensorProximityValue();
+			}
+			GSink = GSink + (int64)Sum;
+		});
+
+		// Three-tile snake through the screen center, rerolled by every drop
+		const int32 Center = (Terminal->GridHeight / 2) * Terminal->GridWidth + Terminal->GridWidth / 2;
+		const TArray<int32> Snake = { Center - 1, Center, Center + 1 };
+		Drop.Measure(Iterations, [Terminal, &Snake, Iterations]()
+		{
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				Terminal->HandleScaryDrop(Snake, i % 4);
+			}
+		});
+
+		// Full hint searches with the default settings; each one is far heavier than a drop
+		const int32 SearchIterations = FMath::Max(Iterations / 20, 1);
+		Snakes.Measure(SearchIterations, [Terminal, SearchIterations]()
+		{
+			const FTerminalSnakeSearchSettings SearchSettings;
+			TArray<FTerminalSnake> Found;
+			for (int32 i = 0; i < SearchIterations; ++i)
+			{
+				GSink = GSink + Terminal->FindBestSnakes(SearchSettings, Found);
+			}
+		});
+
+		// Density counts over growing radii, up to the whole map
+		Density.Measure(Iterations, [Terminal, &Script, Iterations, MapSize]()
+		{
+			int64 Sum = 0;
+			for (int32 i = 0; i < Iterations; ++i)
+			{
+				const float Radius = (float)Script.RandRange(1, FMath::Max(MapSize.X, MapSize.Y) / 2);
+				Sum += Terminal->CountScaryNearView(Radius);
+			}
+			GSink = GSink + Sum;
+		});
+	}
+
+	Numbers.Finish(TEXT("GetGridNumber"), MapSize, Mode, TerminalCount, OutResults);
+	Scroll.Finish(TEXT("ApplyTrackballInput"), MapSize, Mode, TerminalCount, OutResults);
+	Sensor.Finish(TEXT("GetSensorProximityValue"), MapSize, Mode, TerminalCount, OutResults);
+	Drop.Finish(TEXT("HandleScaryDrop"), MapSize, Mode, TerminalCount, OutResults);
+	Snakes.Finish(TEXT("FindBestSnakes"), MapSize, Mode, TerminalCount, OutResults);
+	Density.Finish(TEXT("CountScaryNearView"), MapSize, Mode, TerminalCount, OutResults);
+
+	// ========================================
+	// Step 4: Clean Up
+	// ========================================
+	if (TerminalManager)
+	{
+		TerminalManager->SetActiveTerminal(nullptr);
+	}
+	for (ATerminalActor* Terminal : Terminals)
+	{
+		Terminal->Destroy();
+	}
+}
+
+/**
+ * Plays a recorded session back without waiting for its timestamps, so hours of
+ * play run in seconds. The recording restores its own map, seed and state.
+ */
+void FTerminalBenchmark::RunReplay(UWorld* World, const FTerminalBenchmarkSettings& Settings, TArray<FTerminalBenchmarkResult>& OutResults)
+{
+	using namespace TerminalBenchmark;
+
+	TArray<uint8> Recording;
+	if (!FFileHelper::LoadFileToArray(Recording, *Settings.ReplayPath))
+	{
+		UE_LOG(LogTerminal, Error, TEXT("Benchmark: could not read recording %s"), *Settings.ReplayPath);
+		return;
+	}
+
+	const FTransform SpawnTransform(FVector(0.f, 0.f, -100000.f));
+	ATerminalActor* Terminal = World->SpawnActorDeferred<ATerminalActor>(ATerminalActor::StaticClass(), SpawnTransform);
+	if (!Terminal)
+	{
+		return;
+	}
+	Terminal->bRandomizeDaySeed = false;
+	Terminal->FinishSpawning(SpawnTransform);
+	if (!Terminal->HasActorBegunPlay())
+	{
+		Terminal->DispatchBeginPlay();
+	}
+
+	UTerminalSubsystem* TerminalManager = World->GetSubsystem<UTerminalSubsystem>();
+	if (TerminalManager)
+	{
+		TerminalManager->SetActiveTerminal(Terminal);
+	}
+
+	UE_LOG(LogTerminal, Display, TEXT("Benchmark: replaying %s (%d bytes)"), *Settings.ReplayPath, Recording.Num());
+
+	FAccumulator Replay(World);
+	bool bStarted = false;
+	Replay.Measure(0, [Terminal, &Recording, &bStarted]()
+	{
+		bStarted = Terminal->StartReplay(Recording, false);
+	});
+
+	if (bStarted)
+	{
+		Replay.Ops = Terminal->GetLastReplayRecordCount();
+		Replay.Finish(TEXT("Replay"), FIntPoint(Terminal->GlobalMapWidth, Terminal->GlobalMapHeight), Terminal->GridMode, 1, OutResults);
+	}
+	else
+	{
+		UE_LOG(LogTerminal, Error, TEXT("Benchmark: %s is not a valid terminal recording"), *Settings.ReplayPath);
+	}
+
+	if (TerminalManager)
+	{
+		TerminalManager->SetActiveTerminal(nullptr);
+	}
+	Terminal->Destroy();
+}
+
+// ========================================
+// REPORTING
+// ========================================
+
+/**
+ * One line per result, grouped the way they were run.
+ */
+void FTerminalBenchmark::LogResults(const TArray<FTerminalBenchmarkResult>& Results)
+{
+	UE_LOG(LogTerminal, Display, TEXT("%-24s %11s %-10s %5s %10s %12s %10s %12s"),
+		TEXT("Operation"), TEXT("Map"), TEXT("Mode"), TEXT("Terms"), TEXT("Ops"), TEXT("ns/op"), TEXT("allocs/op"), TEXT("bytes/op"));
+
+	for (const FTerminalBenchmarkResult& Result : Results)
+	{
+		UE_LOG(LogTerminal, Display, TEXT("%-24s %11s %-10s %5d %10lld %12.1f %10.2f %12.1f"),
+			*Result.Operation, *FString::Printf(TEXT("%dx%d"), Result.MapSize.X, Result.MapSize.Y),
+			*TerminalBenchmark::GetModeName(Result.Mode), Result.TerminalCount, Result.Ops,
+			Result.NsPerOp, Result.AllocsPerOp, Result.BytesPerOp);
+	}
+}
+
+/**
+ * CSV for tracking results between builds.
+ */
+FString FTerminalBenchmark::ToCsv(const TArray<FTerminalBenchmarkResult>& Results)
+{
+	FString Csv = TEXT("Operation,Width,Height,Mode,Terminals,Ops,NsPerOp,AllocsPerOp,BytesPerOp\n");
+	for (const FTerminalBenchmarkResult& Result : Results)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%d,%s,%d,%lld,%.1f,%.3f,%.1f\n"),
+			*Result.Operation, Result.MapSize.X, Result.MapSize.Y, *TerminalBenchmark::GetModeName(Result.Mode),
+			Result.TerminalCount, Result.Ops, Result.NsPerOp, Result.AllocsPerOp, Result.BytesPerOp);
+	}
+	return Csv;
+}
+
+// ========================================
+// COMMANDLET
+// ========================================
+
+UTerminalBenchmarkCommandlet::UTerminalBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+/**
+ * Builds a throwaway game world (no level, no ticking) and benchmarks inside it.
+ *
+ * @return 0 on success, 1 if the settings were invalid
+ */
+int32 UTerminalBenchmarkCommandlet::Main(const FString& Params)
+{
+	FTerminalBenchmarkSettings Settings;
+	if (!Settings.ParseCommandLine(*Params))
+	{
+		return 1;
+	}
+
+	// ========================================
+	// Step 1: Create a Bare Game World
+	// ========================================
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TerminalBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	// ========================================
+	// Step 2: Run and Report
+	// ========================================
+	TArray<FTerminalBenchmarkResult> Results;
+	FTerminalBenchmark::Run(World, Settings, Results);
+	FTerminalBenchmark::LogResults(Results);
+
+	FString CsvPath;
+	if (FParse::Value(*Params, TEXT("Csv="), CsvPath))
+	{
+		if (FFileHelper::SaveStringToFile(FTerminalBenchmark::ToCsv(Results), *CsvPath))
+		{
+			UE_LOG(LogTerminal, Display, TEXT("Benchmark results written to %s"), *CsvPath);
+		}
+		else
+		{
+			UE_LOG(LogTerminal, Error, TEXT("Could not write benchmark results to %s"), *CsvPath);
+		}
+	}
+
+	// ========================================
+	// Step 3: Tear Down
+	// ========================================
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return 0;
+}
+
+// ========================================
+// CONSOLE COMMAND
+// ========================================
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Terminal.Benchmark [settings] - runs the benchmark inside the current game world.
+ * Hitches the game for the duration; the active terminal is put back afterwards.
+ */
+static FAutoConsoleCommandWithWorldAndArgs GTerminalBenchmarkCommand(
+	TEXT("Terminal.Benchmark"),
+	TEXT("Times the terminal hot paths in the current world. Same settings as -run=TerminalBenchmark, e.g. Terminal.Benchmark -Sizes=1000x1000 -Terminals=1,4 -Iterations=500"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->HasBegunPlay())
+		{
+			UE_LOG(LogTerminal, Warning, TEXT("Terminal.Benchmark needs a playing world"));
+			return;
+		}
+
+		FTerminalBenchmarkSettings Settings;
+		if (!Settings.ParseCommandLine(*FString::Join(Args, TEXT(" "))))
+		{
+			return;
+		}
+
+		TArray<FTerminalBenchmarkResult> Results;
+		FTerminalBenchmark::Run(World, Settings, Results);
+		FTerminalBenchmark::LogResults(Results);
+	}));
+#endif
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TerminalGridStore.h"
+#include "TerminalBenchmark.generated.h"
+
+class ATerminalActor;
+
+/**
+ * What the terminal benchmark runs.
+ * Every combination of map size, grid mode and terminal count is measured.
+ */
+struct FTerminalBenchmarkSettings
+{
+	/** Global map sizes to build (GlobalMapWidth x GlobalMapHeight) */
+	TArray<FIntPoint> MapSizes = { FIntPoint(1000, 1000), FIntPoint(10000, 10000) };
+
+	/** Grid backends to measure */
+	TArray<ETerminalGridMode> Modes = { ETerminalGridMode::Eager, ETerminalGridMode::Procedural, ETerminalGridMode::Streamed };
+
+	/** Number of terminals spawned side by side */
+	TArray<int32> TerminalCounts = { 1, 4 };
+
+	/** Operations per terminal for the per-frame workloads (scroll, sensor, drop, number reads) */
+	int32 Iterations = 2000;
+
+	/** Grid builds per terminal (each on a fresh seed, so nothing comes from the grid cache) */
+	int32 GenerateIterations = 5;
+
+	/** Seed for the grids and the scripted input */
+	int32 Seed = 1234;
+
+	/**
+	 * Optional session recording (ATerminalActor::StopRecordingToFile) to replay as fast
+	 * as possible after the scripted workloads. Uses the recording's own map settings.
+	 */
+	FString ReplayPath;
+
+	/**
+	 * Reads settings from a command line, e.g.
+	 * -Sizes=1000x1000,4096x4096 -Modes=Procedural,Streamed -Terminals=1,8 -Iterations=5000 -Generate=3 -Seed=7
+	 * -Replay=Saved/Soak.trec
+	 *
+	 * @return false if a value could not be parsed (the settings are left partly updated)
+	 */
+	bool ParseCommandLine(const TCHAR* CommandLine);
+};
+
+/** Timing and allocation totals of one operation in one configuration */
+struct FTerminalBenchmarkResult
+{
+	/** Measured operation, e.g. "ApplyTrackballInput" */
+	FString Operation;
+
+	FIntPoint MapSize = FIntPoint::ZeroValue;
+	ETerminalGridMode Mode = ETerminalGridMode::Eager;
+	int32 TerminalCount = 0;
+
+	/** Operations timed, across all terminals */
+	int64 Ops = 0;
+
+	double NsPerOp = 0.0;
+	double AllocsPerOp = 0.0;
+	double BytesPerOp = 0.0;
+};
+
+/**
+ * Headless workload driver for ATerminalActor hot paths.
+ *
+ * Spawns terminals into a world, then times GenerateGrid, the sensor,
+ * ApplyTrackballInput, HandleScaryDrop, FindBestSnakes, CountScaryNearView and GetGridNumber over a scripted
+ * scroll-and-drop workload. Heap allocations are counted by routing GMalloc
+ * through a counting proxy for the duration of each timed loop. Queued terminal
+ * jobs are flushed first, and only the game thread's allocations are counted, so
+ * the parallel Eager fill reports its main-thread allocations only.
+ *
+ * Run it from the command line with -run=TerminalBenchmark, or in a running
+ * game with the Terminal.Benchmark console command (development builds).
+ */
+class PROJECT_REFINEMENT_API FTerminalBenchmark
+{
+public:
+	/**
+	 * Runs every configuration in an already playing world.
+	 * Spawned terminals are destroyed again; the previously active terminal is restored.
+	 */
+	static void Run(UWorld* World, const FTerminalBenchmarkSettings& Settings, TArray<FTerminalBenchmarkResult>& OutResults);
+
+	/** Writes results to the log as an aligned table */
+	static void LogResults(const TArray<FTerminalBenchmarkResult>& Results);
+
+	/** Formats results as CSV with a header row */
+	static FString ToCsv(const TArray<FTerminalBenchmarkResult>& Results);
+
+private:
+	/** Measures all operations for one map size, mode and terminal count */
+	static void RunConfiguration(UWorld* World, const FTerminalBenchmarkSettings& Settings,
+		FIntPoint MapSize, ETerminalGridMode Mode, int32 TerminalCount, TArray<FTerminalBenchmarkResult>& OutResults);
+
+	/** Replays Settings.ReplayPath on one terminal; one op per replayed record */
+	static void RunReplay(UWorld* World, const FTerminalBenchmarkSettings& Settings, TArray<FTerminalBenchmarkResult>& OutResults);
+};
+
+/**
+ * Commandlet entry point for the terminal benchmark.
+ * Creates a bare game world, runs FTerminalBenchmark in it and logs the results.
+ *
+ * Usage: UnrealEditor-Cmd Project_Refinement.uproject -run=TerminalBenchmark [settings] [-Csv=Path]
+ * See FTerminalBenchmarkSettings::ParseCommandLine for the settings.
+ * Allocation columns count the game thread only; worker threads are timed but not counted.
+ */
+UCLASS()
+class PROJECT_REFINEMENT_API UTerminalBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTerminalBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
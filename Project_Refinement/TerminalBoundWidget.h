@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "TerminalBoundWidget.generated.h"
+
+class ATerminalActor;
+
+UINTERFACE(MinimalAPI, Blueprintable)
+class UTerminalBoundWidget : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by terminal UI widgets that are pooled by APlayerCharacter.
+ *
+ * The same widget instance is reused for every sit-down, so anything it reads
+ * from a terminal (delegates, cached references) must be set up in BindToTerminal
+ * and torn down in UnbindFromTerminal rather than in Construct / Destruct.
+ */
+class PROJECT_REFINEMENT_API ITerminalBoundWidget
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * The player sat down at Terminal and the widget is about to be shown.
+	 * Called every sit-down, also when it is the same terminal as last time.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Terminal|UI")
+	void BindToTerminal(ATerminalActor* Terminal);
+
+	/** The player stood up; the widget is collapsed right after this */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Terminal|UI")
+	void UnbindFromTerminal();
+};
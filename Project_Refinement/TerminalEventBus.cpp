@@ -0,0 +1,138 @@
+#include "TerminalEventBus.h"
+#include "TerminalActor.h"
+#include "TerminalStats.h"
+#include "Engine/World.h"
+
+/**
+ * Hooks the end-of-frame dispatch.
+ */
+void UTerminalEventBus::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UTerminalEventBus::HandleWorldPostActorTick);
+}
+
+/**
+ * Drops anything still queued; the world is going away.
+ */
+void UTerminalEventBus::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	Queue.Empty();
+	QueueIndex.Empty();
+	Dispatching.Empty();
+	OnEvent.Clear();
+	OnEventBatch.Clear();
+
+	Super::Deinitialize();
+}
+
+// ========================================
+// POSTING
+// ========================================
+
+/**
+ * Finds the pending event a new one merges into.
+ */
+FTerminalEvent& UTerminalEventBus::FindOrQueue(ATerminalActor* Terminal, ETerminalEventType Type, int32 KeyIndex)
+{
+	INC_DWORD_STAT(STAT_TerminalEventsPosted);
+
+	FCoalesceKey Key;
+	Key.Terminal = Terminal;
+	Key.Type = Type;
+	Key.Index = KeyIndex;
+
+	if (const int32* Existing = QueueIndex.Find(Key))
+	{
+		return Queue[*Existing];
+	}
+
+	QueueIndex.Add(Key, Queue.Num());
+	FTerminalEvent& Event = Queue.AddDefaulted_GetRef();
+	Event.Terminal = Terminal;
+	Event.Type = Type;
+	return Event;
+}
+
+void UTerminalEventBus::PostProgressUpdated(ATerminalActor* Terminal, int32 BarIndex, float NewValue)
+{
+	FTerminalEvent& Event = FindOrQueue(Terminal, ETerminalEventType::ProgressUpdated, BarIndex);
+	Event.Index = BarIndex;
+	Event.Value = NewValue;
+	Event.Count++;
+}
+
+void UTerminalEventBus::PostChunkConsumed(ATerminalActor* Terminal)
+{
+	FindOrQueue(Terminal, ETerminalEventType::ChunkConsumed, 0).Count++;
+}
+
+void UTerminalEventBus::PostGridScrolled(ATerminalActor* Terminal)
+{
+	FindOrQueue(Terminal, ETerminalEventType::GridScrolled, 0).Count++;
+}
+
+void UTerminalEventBus::PostFileCompleted(ATerminalActor* Terminal, int32 FilesDone, int32 FilesTarget)
+{
+	FTerminalEvent& Event = FindOrQueue(Terminal, ETerminalEventType::FileCompleted, 0);
+	Event.Index = FilesDone;
+	Event.Count = FilesTarget;
+}
+
+// ========================================
+// DISPATCH
+// ========================================
+
+/**
+ * Flushes after every actor in this world has ticked.
+ */
+void UTerminalEventBus::HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		Flush();
+	}
+}
+
+/**
+ * Dispatches the coalesced queue.
+ * The queue is swapped out first, so subscribers that post (or flush) while
+ * handling an event can't modify the array being walked.
+ */
+void UTerminalEventBus::Flush()
+{
+	if (Queue.Num() == 0 || Dispatching.Num() > 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR("Terminal.EventBus.Flush");
+
+	Swap(Queue, Dispatching);
+	QueueIndex.Reset();
+
+	for (const FTerminalEvent& Event : Dispatching)
+	{
+		ATerminalActor* Terminal = Event.Terminal.Get();
+		if (!Terminal)
+		{
+			// Destroyed since posting
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_TerminalEventsDispatched);
+
+		if (Terminal->bCoalesceEvents)
+		{
+			Terminal->DispatchTerminalEvent(Event);
+		}
+		OnEvent.Broadcast(Event);
+	}
+
+	OnEventBatch.Broadcast(Dispatching);
+	Dispatching.Reset();
+}
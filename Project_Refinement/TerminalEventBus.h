@@ -0,0 +1,157 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TerminalEventBus.generated.h"
+
+class ATerminalActor;
+
+/** Kinds of terminal notifications carried by the event bus */
+UENUM(BlueprintType)
+enum class ETerminalEventType : uint8
+{
+	/** A progress bar changed. Index = bar, Value = new fill. Last value per bar wins. */
+	ProgressUpdated,
+
+	/** Chunks were applied to bars. Count = chunks this frame. */
+	ChunkConsumed,
+
+	/** The integer scroll position changed. Count = scroll steps merged into this event. */
+	GridScrolled,
+
+	/** A file was completed. Index = files done, Count = files target. Last one wins. */
+	FileCompleted
+};
+
+/**
+ * One (possibly coalesced) terminal notification.
+ */
+USTRUCT(BlueprintType)
+struct FTerminalEvent
+{
+	GENERATED_BODY()
+
+	/** Terminal that raised the event */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Events")
+	TWeakObjectPtr<ATerminalActor> Terminal;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Events")
+	ETerminalEventType Type = ETerminalEventType::ProgressUpdated;
+
+	/** Bar index (ProgressUpdated) or files done (FileCompleted) */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Events")
+	int32 Index = 0;
+
+	/** Bar fill (ProgressUpdated) */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Events")
+	float Value = 0.f;
+
+	/** Merged occurrences (ChunkConsumed, GridScrolled) or files target (FileCompleted) */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Events")
+	int32 Count = 0;
+};
+
+/** Fired once per dispatched event */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTerminalEvent, const FTerminalEvent&);
+
+/** Fired once per frame with every event dispatched that frame (for telemetry) */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTerminalEventBatch, TConstArrayView<FTerminalEvent>);
+
+/**
+ * Terminal Event Bus - end-of-frame, coalesced terminal notifications.
+ *
+ * Terminals post here from their hot paths instead of calling Blueprint events
+ * directly. Events are queued for the rest of the frame with duplicates merged:
+ * - ProgressUpdated: one event per (terminal, bar), holding the last value
+ * - GridScrolled / ChunkConsumed: one event per terminal, Count summed
+ * - FileCompleted: one event per terminal, the last counts
+ *
+ * After all actors have ticked the queue is dispatched once, in the order each
+ * event was first posted: to the terminal's own Blueprint events (when its
+ * bCoalesceEvents is set), then to native subscribers (UI, audio, telemetry).
+ * Subscribers bind with AddUObject / AddWeakLambda, so the bus never keeps them
+ * alive and terminals never need to know about them.
+ */
+UCLASS()
+class PROJECT_REFINEMENT_API UTerminalEventBus : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// ========================================
+	// Posting
+	// ========================================
+
+	/** Queues a bar change; replaces an earlier change to the same bar this frame */
+	void PostProgressUpdated(ATerminalActor* Terminal, int32 BarIndex, float NewValue);
+
+	/** Queues a consumed chunk; merged with earlier ones from the same terminal */
+	void PostChunkConsumed(ATerminalActor* Terminal);
+
+	/** Queues a scroll; merged with earlier scrolls of the same terminal */
+	void PostGridScrolled(ATerminalActor* Terminal);
+
+	/** Queues a file completion; replaces an earlier one from the same terminal */
+	void PostFileCompleted(ATerminalActor* Terminal, int32 FilesDone, int32 FilesTarget);
+
+	// ========================================
+	// Dispatch
+	// ========================================
+
+	/**
+	 * Dispatches the queue now instead of at the end of the frame.
+	 * Events posted by subscribers during dispatch wait for the next flush.
+	 */
+	void Flush();
+
+	/** Events waiting for dispatch (after coalescing) */
+	int32 GetPendingEventCount() const { return Queue.Num(); }
+
+	/** Fired for each dispatched event */
+	FOnTerminalEvent OnEvent;
+
+	/** Fired once per flush with all dispatched events */
+	FOnTerminalEventBatch OnEventBatch;
+
+private:
+	/** What makes two queued events duplicates */
+	struct FCoalesceKey
+	{
+		const ATerminalActor* Terminal = nullptr;
+		ETerminalEventType Type = ETerminalEventType::ProgressUpdated;
+		int32 Index = 0;
+
+		bool operator==(const FCoalesceKey& Other) const
+		{
+			return Terminal == Other.Terminal && Type == Other.Type && Index == Other.Index;
+		}
+
+		friend uint32 GetTypeHash(const FCoalesceKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Terminal), GetTypeHash((uint8)Key.Type)), GetTypeHash(Key.Index));
+		}
+	};
+
+	/**
+	 * Returns the queued event for a key, adding an empty one (with Count 0) if there is none.
+	 * KeyIndex is the extra key part (bar index for ProgressUpdated, 0 otherwise).
+	 */
+	FTerminalEvent& FindOrQueue(ATerminalActor* Terminal, ETerminalEventType Type, int32 KeyIndex);
+
+	/** End-of-frame hook (FWorldDelegates::OnWorldPostActorTick) */
+	void HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	/** Coalesced events, in first-posted order */
+	TArray<FTerminalEvent> Queue;
+
+	/** Queue index of each key */
+	TMap<FCoalesceKey, int32> QueueIndex;
+
+	/** Events being dispatched (kept to reuse its allocation) */
+	TArray<FTerminalEvent> Dispatching;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,928 @@
+#include "TerminalGridStore.h"
+#include "Project_Refinement.h"
+#include "TerminalSensorKernel.h"
+#include "TerminalStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "Serialization/Archive.h"
+
+/**
+ * Allocates storage for the map and clears every cell.
+ * Procedural mode skips the per-cell allocation entirely;
+ * Streamed mode also skips the scary mask and spatial index.
+ */
+void FTerminalGridStore::Init(int32 InWidth, int32 InHeight, ETerminalGridMode InMode, int32 InSeed)
+{
+	Width = FMath::Max(InWidth, 1);
+	Height = FMath::Max(InHeight, 1);
+
+	// Global indices are int32 - shorten maps that would overflow them
+	if ((int64)Width * Height > MAX_int32)
+	{
+		Height = MAX_int32 / Width;
+		UE_LOG(LogTerminal, Warning, TEXT("Grid of %dx%d exceeds 2^31 cells, height clamped to %d"), InWidth, InHeight, Height);
+	}
+
+	TotalCount = Width * Height;
+	SectorsX = FMath::DivideAndRoundUp(Width, SectorSize);
+	SectorsY = FMath::DivideAndRoundUp(Height, SectorSize);
+	Mode = InMode;
+	Seed = InSeed;
+
+	// Masks for the inline accessors; same rule as DispatchTerminalWrap
+	bPowerOfTwo = FMath::IsPowerOfTwo(Width) && FMath::IsPowerOfTwo(Height);
+	WidthMask = bPowerOfTwo ? Width - 1 : 0;
+	HeightMask = bPowerOfTwo ? Height - 1 : 0;
+	WidthShift = bPowerOfTwo ? (int32)FMath::FloorLog2((uint32)Width) : 0;
+
+	// Always start from fresh data, any copies of the previous grid keep theirs
+	Data = MakeShared<FGridData, ESPMode::ThreadSafe>();
+	if (Mode == ETerminalGridMode::Eager)
+	{
+		Data->Cells.Init(0, TotalCount);
+	}
+
+	Data->ScaryDensity.Init(Width, Height, SectorSize);
+
+	Overrides.Reset();
+	SeededCells.Reset();
+	ScaryOverrides.Reset();
+	SectorCache.Configure(SectorCache.GetBudget(), SectorSize);
+	bLocalWrites = false;
+
+	// Streamed scary state is the seeded layout plus ScaryOverrides, no per-cell bits
+	if (Mode != ETerminalGridMode::Streamed)
+	{
+		Data->ScaryMask.Init(false, TotalCount);
+		Data->ScaryIndex.Init(Width, Height, SectorSize);
+	}
+}
+
+/**
+ * Builds a full day grid from a seed.
+ */
+void FTerminalGridStore::Generate(int32 InWidth, int32 InHeight, ETerminalGridMode InMode, int32 InSeed)
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalBuildGridStore, "Terminal.BuildGridStore");
+
+	Init(InWidth, InHeight, InMode, InSeed);
+
+	// ========================================
+	// Step 1: Fill Grid with Random Numbers (1-9)
+	// ========================================
+	// Procedural grids compute every cell from the seed on demand,
+	// so only Eager grids need to roll the whole map here (in parallel row blocks)
+	FillRandomNumbers(InSeed);
+
+	// ========================================
+	// Step 2: Spawn Scary Numbers (Sector Pattern)
+	// ========================================
+	SpawnSectorScaryTiles(InSeed);
+
+	// The generated layout is the baseline, not a local change
+	bLocalWrites = false;
+}
+
+/**
+ * Divides the grid into 50x50 sectors and spawns one scary number per sector.
+ * This ensures even distribution across the infinite grid.
+ */
+void FTerminalGridStore::SpawnSectorScaryTiles(int32 InSeed)
+{
+	// Streamed picks are recomputed per sector on demand, only the totals are stored
+	// (every pick is clamped into its own sector, so each sector holds exactly one)
+	if (Mode == ETerminalGridMode::Streamed)
+	{
+		FGridData& MutableData = GetMutableData();
+		MutableData.ScaryCount = SectorsX * SectorsY;
+		MutableData.ScaryDensity.Fill(1);
+		return;
+	}
+
+	TArray<int32> ScaryPicks;
+	ComputeSectorScaryPicks(InSeed, ScaryPicks);
+
+	// Marking is serial: neighbouring bits share words and the spatial index isn't thread-safe
+	for (const int32 GlobalIdx : ScaryPicks)
+	{
+		SetScary(GlobalIdx, true);
+		UE_LOG(LogTerminal, Verbose, TEXT("Scary Number spawned at Global Index: %d"), GlobalIdx);
+	}
+}
+
+/**
+ * Picks one tile per sector in parallel, each sector with its own seeded stream.
+ * Pure function of the seed and map size, so snapshots can recompute the layout.
+ */
+void FTerminalGridStore::ComputeSectorScaryPicks(int32 InSeed, TArray<int32>& OutPicks) const
+{
+	OutPicks.SetNumUninitialized(SectorsX * SectorsY);
+
+	ParallelFor(OutPicks.Num(), [this, &OutPicks, InSeed](int32 SectorIndex)
+	{
+		OutPicks[SectorIndex] = GetSectorScaryPick(InSeed, SectorIndex);
+	});
+}
+
+/**
+ * Seeded scary tile of one sector. Each sector has its own stream,
+ * so any sector can be evaluated on its own in O(1).
+ */
+int32 FTerminalGridStore::GetSectorScaryPick(int32 InSeed, int32 SectorIndex) const
+{
+	FRandomStream ScaryStream((int32)HashCombine(GetTypeHash(InSeed), GetTypeHash(~SectorIndex)));
+
+	// Pick a random tile within this 50x50 block
+	// Offset by 5 to avoid edges
+	const int32 RandX = (SectorIndex % SectorsX) * SectorSize + ScaryStream.RandRange(5, SectorSize - 5);
+	const int32 RandY = (SectorIndex / SectorsX) * SectorSize + ScaryStream.RandRange(5, SectorSize - 5);
+
+	// Keep the pick inside its own sector, so partial sectors at the map edge (e.g. on a
+	// 1024 map) never land on sector 0's tiles and every mode gets the same layout
+	return FMath::Min(RandY, Height - 1) * Width + FMath::Min(RandX, Width - 1);
+}
+
+/**
+ * Frees all storage.
+ */
+void FTerminalGridStore::Reset()
+{
+	Width = 0;
+	Height = 0;
+	TotalCount = 0;
+	SectorsX = 0;
+	SectorsY = 0;
+	bPowerOfTwo = false;
+	WidthMask = 0;
+	HeightMask = 0;
+	WidthShift = 0;
+	Data.Reset();
+	Overrides.Empty();
+	SeededCells.Empty();
+	ScaryOverrides.Empty();
+	SectorCache.Empty();
+	bLocalWrites = false;
+}
+
+/**
+ * Fills the map with random numbers, one independent RNG stream per row block.
+ */
+void FTerminalGridStore::FillRandomNumbers(int32 InSeed)
+{
+	if (Mode != ETerminalGridMode::Eager || TotalCount == 0)
+	{
+		return;
+	}
+
+	const int32 CellsPerBlock = RowsPerFillBlock * Width;
+	const int32 NumBlocks = FMath::DivideAndRoundUp(TotalCount, CellsPerBlock);
+	uint8* CellData = GetMutableData().Cells.GetData();
+	const int32 CellCount = TotalCount;
+
+	ParallelFor(NumBlocks, [CellData, CellCount, CellsPerBlock, InSeed](int32 BlockIndex)
+	{
+		// Seed per block (not per thread) so the output doesn't depend on scheduling
+		FRandomStream Stream((int32)HashCombine(GetTypeHash(InSeed), GetTypeHash(BlockIndex)));
+
+		const int32 First = BlockIndex * CellsPerBlock;
+		const int32 Last = FMath::Min(First + CellsPerBlock, CellCount);
+		for (int32 i = First; i < Last; ++i)
+		{
+			CellData[i] = (uint8)Stream.RandRange(1, 9);
+		}
+	});
+}
+
+/**
+ * Stores a number, either directly (Eager) or as an override (Procedural).
+ */
+void FTerminalGridStore::SetNumber(int32 Index, int32 Value)
+{
+	if (!IsValidIndex(Index))
+	{
+		return;
+	}
+
+	bLocalWrites = true;
+
+	if (Mode == ETerminalGridMode::Eager)
+	{
+		const uint8 Current = Data->Cells[Index];
+		if (Current != (uint8)Value)
+		{
+			GetMutableData().Cells[Index] = (uint8)Value;
+		}
+
+		// A cell without an override still holds its generated value
+		const uint8* KnownSeeded = SeededCells.Find(Index);
+		const uint8 SeededValue = KnownSeeded ? *KnownSeeded : Current;
+
+		// Same rule as below: only keep overrides that differ from the generated value
+		if ((uint8)Value == SeededValue)
+		{
+			Overrides.Remove(Index);
+			SeededCells.Remove(Index);
+		}
+		else
+		{
+			Overrides.Add(Index, (uint8)Value);
+			if (!KnownSeeded)
+			{
+				SeededCells.Add(Index, Current);
+			}
+		}
+		return;
+	}
+
+	// Only keep overrides that actually differ from the seeded value
+	if (Value == GetSeededNumber(Seed, Index))
+	{
+		Overrides.Remove(Index);
+	}
+	else
+	{
+		Overrides.Add(Index, (uint8)Value);
+	}
+
+	// Keep a resident sector in step; evicted sectors pick the override up when rebuilt
+	if (Mode == ETerminalGridMode::Streamed)
+	{
+		if (FTerminalSector* Sector = SectorCache.Find(GetSectorIndex(Index)))
+		{
+			const int32 LocalX = (Index % Width) % SectorSize;
+			const int32 LocalY = (Index / Width) % SectorSize;
+			Sector->Numbers[LocalY * SectorSize + LocalX] = (uint8)Value;
+		}
+	}
+}
+
+/**
+ * Bulk number read for one contiguous run.
+ * The storage mode is resolved once per run instead of once per cell.
+ */
+void FTerminalGridStore::ReadNumbers(int32 StartIndex, int32 Count, int32* OutNumbers) const
+{
+	check(StartIndex >= 0 && StartIndex + Count <= TotalCount);
+
+	// Copy row pieces straight out of the cached sectors
+	if (Mode == ETerminalGridMode::Streamed)
+	{
+		const int32 Y = StartIndex / Width;
+		const int32 LocalY = Y % SectorSize;
+		int32 X = StartIndex % Width;
+		int32 Written = 0;
+
+		while (Written < Count)
+		{
+			const int32 LocalX = X % SectorSize;
+			const int32 PieceCount = FMath::Min(Count - Written, SectorSize - LocalX);
+			const FTerminalSector& Sector = GetStreamedSector(GetSectorIndex(Y * Width + X));
+			const uint8* Src = Sector.Numbers.GetData() + LocalY * SectorSize + LocalX;
+
+			for (int32 i = 0; i < PieceCount; ++i)
+			{
+				OutNumbers[Written + i] = Src[i];
+			}
+
+			Written += PieceCount;
+			X += PieceCount;
+		}
+		return;
+	}
+
+	if (Mode == ETerminalGridMode::Eager)
+	{
+		const uint8* Src = Data->Cells.GetData() + StartIndex;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutNumbers[i] = Src[i];
+		}
+		return;
+	}
+
+	// Fresh day - nothing eaten yet, so skip the override lookups entirely
+	if (Overrides.Num() == 0)
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutNumbers[i] = GetSeededNumber(Seed, StartIndex + i);
+		}
+		return;
+	}
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const uint8* Override = Overrides.Find(StartIndex + i);
+		OutNumbers[i] = Override ? *Override : GetSeededNumber(Seed, StartIndex + i);
+	}
+}
+
+/**
+ * Bulk scary flag read for one contiguous run.
+ */
+void FTerminalGridStore::ReadScary(int32 StartIndex, int32 Count, bool* OutScary) const
+{
+	check(StartIndex >= 0 && StartIndex + Count <= TotalCount);
+
+	// Most of the map is calm
+	if (Data->ScaryCount == 0)
+	{
+		FMemory::Memzero(OutScary, Count * sizeof(bool));
+		return;
+	}
+
+	// Streamed sectors list their few scary tiles; mark the ones on this run
+	if (Mode == ETerminalGridMode::Streamed)
+	{
+		FMemory::Memzero(OutScary, Count * sizeof(bool));
+
+		const int32 Y = StartIndex / Width;
+		const int32 FirstX = StartIndex % Width;
+		const int32 LastX = FirstX + Count - 1;
+
+		for (int32 X = FirstX; X <= LastX; X += SectorSize - X % SectorSize)
+		{
+			for (const FIntPoint& Tile : GetStreamedSector(GetSectorIndex(Y * Width + X)).ScaryTiles)
+			{
+				if (Tile.Y == Y && Tile.X >= FirstX && Tile.X <= LastX)
+				{
+					OutScary[Tile.X - FirstX] = true;
+				}
+			}
+		}
+		return;
+	}
+
+	const TBitArray<>& ScaryMask = Data->ScaryMask;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutScary[i] = ScaryMask[StartIndex + i];
+	}
+}
+
+/**
+ * Sets or clears a scary flag, keeping the cached scary count,
+ * the spatial index and the density table in sync.
+ * Shared data is only copied when the flag actually changes.
+ */
+void FTerminalGridStore::SetScary(int32 Index, bool bScary)
+{
+	if (!IsValidIndex(Index) || IsScary(Index) == bScary)
+	{
+		return;
+	}
+
+	bLocalWrites = true;
+
+	// Streamed: record the difference to the seeded layout and patch a resident sector
+	if (Mode == ETerminalGridMode::Streamed)
+	{
+		const int32 SectorIndex = GetSectorIndex(Index);
+		if (bScary == (GetSectorScaryPick(Seed, SectorIndex) == Index))
+		{
+			ScaryOverrides.Remove(Index);
+		}
+		else
+		{
+			ScaryOverrides.Add(Index, bScary);
+		}
+
+		const FIntPoint Tile(Index % Width, Index / Width);
+		FGridData& MutableData = GetMutableData();
+		if (bScary)
+		{
+			++MutableData.ScaryCount;
+			MutableData.ScaryDensity.Add(Tile.X, Tile.Y);
+		}
+		else
+		{
+			--MutableData.ScaryCount;
+			MutableData.ScaryDensity.Remove(Tile.X, Tile.Y);
+		}
+
+		if (FTerminalSector* Sector = SectorCache.Find(SectorIndex))
+		{
+			if (bScary)
+			{
+				Sector->ScaryTiles.Add(Tile);
+			}
+			else
+			{
+				Sector->ScaryTiles.RemoveSingleSwap(Tile);
+			}
+		}
+		return;
+	}
+
+	FGridData& MutableData = GetMutableData();
+	MutableData.ScaryMask[Index] = bScary;
+
+	const int32 X = Index % Width;
+	const int32 Y = Index / Width;
+	if (bScary)
+	{
+		++MutableData.ScaryCount;
+		MutableData.ScaryIndex.Add(X, Y);
+		MutableData.ScaryDensity.Add(X, Y);
+	}
+	else
+	{
+		--MutableData.ScaryCount;
+		MutableData.ScaryIndex.Remove(X, Y);
+		MutableData.ScaryDensity.Remove(X, Y);
+	}
+}
+
+/**
+ * Writing back a seeded value removes an override, so a long day leaves
+ * the maps sparse; compacting packs the remaining entries densely again.
+ */
+void FTerminalGridStore::CompactChanges()
+{
+	Overrides.Compact();
+	Overrides.Shrink();
+	SeededCells.Compact();
+	SeededCells.Shrink();
+	ScaryOverrides.Compact();
+	ScaryOverrides.Shrink();
+}
+
+// ========================================
+// STREAMING
+// ========================================
+
+/**
+ * Scary lookup without materializing anything.
+ * Point queries (e.g. random prime picks) probe all over the map,
+ * so they must not evict the sectors around the view.
+ */
+bool FTerminalGridStore::IsStreamedScary(int32 Index) const
+{
+	const int32 SectorIndex = GetSectorIndex(Index);
+	if (const FTerminalSector* Sector = SectorCache.Find(SectorIndex))
+	{
+		return Sector->ScaryTiles.Contains(FIntPoint(Index % Width, Index / Width));
+	}
+
+	if (const bool* Override = ScaryOverrides.Find(Index))
+	{
+		return *Override;
+	}
+
+	return GetSectorScaryPick(Seed, SectorIndex) == Index;
+}
+
+/**
+ * Returns a resident sector (marking it as recently used) or builds it.
+ */
+const FTerminalSector& FTerminalGridStore::GetStreamedSector(int32 SectorIndex) const
+{
+	if (const FTerminalSector* Sector = SectorCache.FindAndTouch(SectorIndex))
+	{
+		return *Sector;
+	}
+
+	FTerminalSector& NewSector = SectorCache.Add(SectorIndex);
+	MaterializeSector(SectorIndex, NewSector);
+	return NewSector;
+}
+
+/**
+ * Rebuilds a sector from the seed, then applies the eaten tiles and scary changes inside it.
+ */
+void FTerminalGridStore::MaterializeSector(int32 SectorIndex, FTerminalSector& OutSector) const
+{
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalMaterializeSector, "Terminal.MaterializeSector");
+
+	const int32 OriginX = (SectorIndex % SectorsX) * SectorSize;
+	const int32 OriginY = (SectorIndex / SectorsX) * SectorSize;
+	const int32 SpanX = FMath::Min(SectorSize, Width - OriginX);
+	const int32 SpanY = FMath::Min(SectorSize, Height - OriginY);
+	uint8* Numbers = OutSector.Numbers.GetData();
+
+	// ========================================
+	// Step 1: Seeded Numbers
+	// ========================================
+	for (int32 LocalY = 0; LocalY < SpanY; ++LocalY)
+	{
+		const int32 RowStart = (OriginY + LocalY) * Width + OriginX;
+		uint8* Row = Numbers + LocalY * SectorSize;
+		for (int32 LocalX = 0; LocalX < SpanX; ++LocalX)
+		{
+			Row[LocalX] = (uint8)GetSeededNumber(Seed, RowStart + LocalX);
+		}
+	}
+
+	// ========================================
+	// Step 2: Eaten Tiles
+	// ========================================
+	// Walk whichever is smaller: the override map or the sector's cells
+	if (Overrides.Num() < SpanX * SpanY)
+	{
+		for (const TPair<int32, uint8>& Override : Overrides)
+		{
+			const int32 LocalX = Override.Key % Width - OriginX;
+			const int32 LocalY = Override.Key / Width - OriginY;
+			if (LocalX >= 0 && LocalX < SpanX && LocalY >= 0 && LocalY < SpanY)
+			{
+				Numbers[LocalY * SectorSize + LocalX] = Override.Value;
+			}
+		}
+	}
+	else
+	{
+		for (int32 LocalY = 0; LocalY < SpanY; ++LocalY)
+		{
+			const int32 RowStart = (OriginY + LocalY) * Width + OriginX;
+			for (int32 LocalX = 0; LocalX < SpanX; ++LocalX)
+			{
+				if (const uint8* Override = Overrides.Find(RowStart + LocalX))
+				{
+					Numbers[LocalY * SectorSize + LocalX] = *Override;
+				}
+			}
+		}
+	}
+
+	// ========================================
+	// Step 3: Scary Tiles
+	// ========================================
+	// Scary changes are rare (a few per day), so a full walk is cheap
+	OutSector.ScaryTiles.Reset();
+
+	const int32 Pick = GetSectorScaryPick(Seed, SectorIndex);
+	const bool* PickOverride = ScaryOverrides.Find(Pick);
+	if (!PickOverride || *PickOverride)
+	{
+		OutSector.ScaryTiles.Add(FIntPoint(Pick % Width, Pick / Width));
+	}
+
+	for (const TPair<int32, bool>& Override : ScaryOverrides)
+	{
+		if (Override.Value && GetSectorIndex(Override.Key) == SectorIndex)
+		{
+			OutSector.ScaryTiles.Add(FIntPoint(Override.Key % Width, Override.Key / Width));
+		}
+	}
+}
+
+/**
+ * Materializes every sector touched by a rectangle of raw coordinates.
+ */
+void FTerminalGridStore::PrefetchSectors(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const
+{
+	if (Mode != ETerminalGridMode::Streamed || TotalCount == 0)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<8>> Columns;
+	TArray<int32, TInlineAllocator<8>> Rows;
+	FTerminalScaryIndex::GatherSectorSpan(MinX, MaxX, Width, SectorSize, SectorsX, Columns);
+	FTerminalScaryIndex::GatherSectorSpan(MinY, MaxY, Height, SectorSize, SectorsY, Rows);
+
+	for (const int32 SectorY : Rows)
+	{
+		for (const int32 SectorX : Columns)
+		{
+			GetStreamedSector(SectorY * SectorsX + SectorX);
+		}
+	}
+}
+
+/**
+ * Resizes the sector cache for a new budget.
+ */
+void FTerminalGridStore::SetStreamingBudget(SIZE_T BudgetBytes)
+{
+	SectorCache.Configure(BudgetBytes, SectorSize);
+}
+
+static TAutoConsoleVariable<int32> CVarTerminalSensorKernel(
+	TEXT("Terminal.SensorKernel"),
+	0,
+	TEXT("Nearest-scary search for Eager and Procedural grids:\n")
+	TEXT("0 = pick per query from the scary density, 1 = always the sector index, 2 = always the dense bitset scan"));
+
+/**
+ * Eager/Procedural: the sector index while scary tiles are sparse, the dense bitset
+ * scan once the sectors around the query hold more tiles than scanning the rows costs.
+ * The density table counts those tiles in O(1), so the choice is made per query.
+ * Streamed: sector cache walk.
+ */
+bool FTerminalGridStore::FindNearestScary(float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared) const
+{
+	if (!Data.IsValid() || Data->ScaryCount == 0 || MaxDistance <= 0.f)
+	{
+		return false;
+	}
+
+	if (Mode != ETerminalGridMode::Streamed)
+	{
+		const int32 Kernel = CVarTerminalSensorKernel.GetValueOnAnyThread();
+		const bool bDense = Kernel == 2 || (Kernel == 0 && FTerminalSensorKernel::ShouldUseDense(
+			Data->ScaryDensity.CountInRadius(CenterX, CenterY, MaxDistance), MaxDistance, Height));
+
+		if (bDense)
+		{
+			INC_DWORD_STAT(STAT_TerminalDenseSensorQueries);
+			return FTerminalSensorKernel::FindNearest(Data->ScaryMask, Width, Height, CenterX, CenterY, MaxDistance, OutDistanceSquared);
+		}
+		return Data->ScaryIndex.FindNearest(CenterX, CenterY, MaxDistance, OutDistanceSquared);
+	}
+
+	// Wrap the query point onto the map so tile coordinates can be compared directly
+	const float WrappedCenterX = CenterX - Width * FMath::FloorToFloat(CenterX / Width);
+	const float WrappedCenterY = CenterY - Height * FMath::FloorToFloat(CenterY / Height);
+
+	TArray<int32, TInlineAllocator<8>> Columns;
+	TArray<int32, TInlineAllocator<8>> Rows;
+	FTerminalScaryIndex::GatherSectorSpan(FMath::FloorToInt(CenterX - MaxDistance), FMath::CeilToInt(CenterX + MaxDistance), Width, SectorSize, SectorsX, Columns);
+	FTerminalScaryIndex::GatherSectorSpan(FMath::FloorToInt(CenterY - MaxDistance), FMath::CeilToInt(CenterY + MaxDistance), Height, SectorSize, SectorsY, Rows);
+
+	float MinDistSq = FMath::Square(MaxDistance);
+	bool bFound = false;
+
+	for (const int32 SectorY : Rows)
+	{
+		for (const int32 SectorX : Columns)
+		{
+			for (const FIntPoint& Tile : GetStreamedSector(SectorY * SectorsX + SectorX).ScaryTiles)
+			{
+				const float DistSq = FTerminalScaryIndex::GetTorusDistanceSquared(Tile.X, Tile.Y, WrappedCenterX, WrappedCenterY, Width, Height);
+				if (DistSq < MinDistSq)
+				{
+					MinDistSq = DistSq;
+					bFound = true;
+				}
+			}
+		}
+	}
+
+	OutDistanceSquared = MinDistSq;
+	return bFound;
+}
+
+// ========================================
+// SNAPSHOTS
+// ========================================
+
+namespace TerminalGridSnapshot
+{
+	/** Writes a sorted index list as a count followed by packed gaps */
+	static void WriteIndexList(FArchive& Ar, TArray<int32>& Indices)
+	{
+		Indices.Sort();
+
+		uint32 Count = (uint32)Indices.Num();
+		Ar.SerializeIntPacked(Count);
+
+		int32 Previous = 0;
+		for (const int32 Index : Indices)
+		{
+			uint32 Gap = (uint32)(Index - Previous);
+			Ar.SerializeIntPacked(Gap);
+			Previous = Index;
+		}
+	}
+
+	/** Reads a list written by WriteIndexList, rejecting indices outside [0, MaxIndex) */
+	static bool ReadIndexList(FArchive& Ar, int32 MaxIndex, TArray<int32>& OutIndices)
+	{
+		uint32 Count = 0;
+		Ar.SerializeIntPacked(Count);
+		if (Ar.IsError() || Count > (uint32)MaxIndex)
+		{
+			return false;
+		}
+
+		OutIndices.Reset(Count);
+		int64 Index = 0;
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			uint32 Gap = 0;
+			Ar.SerializeIntPacked(Gap);
+			Index += Gap;
+			if (Ar.IsError() || Index >= MaxIndex)
+			{
+				return false;
+			}
+			OutIndices.Add((int32)Index);
+		}
+		return true;
+	}
+}
+
+/**
+ * Writes the overrides and scary state on top of the seeded grid.
+ * 
+ * Layout:
+ * - Override indices (packed gap list), then one byte per override value
+ * - uint8 scary flag: 1 = delta lists (added, removed), 0 = full mask
+ */
+void FTerminalGridStore::WriteChanges(FArchive& Ar, bool bDeltaScary) const
+{
+	check(Ar.IsSaving());
+
+	// ========================================
+	// Step 1: Number Overrides
+	// ========================================
+	TArray<int32> OverrideIndices;
+	Overrides.GenerateKeyArray(OverrideIndices);
+	TerminalGridSnapshot::WriteIndexList(Ar, OverrideIndices);
+
+	for (const int32 Index : OverrideIndices)
+	{
+		uint8 Value = Overrides.FindChecked(Index);
+		Ar << Value;
+	}
+
+	// ========================================
+	// Step 2: Scary State
+	// ========================================
+	// Streamed grids have no full mask to write (and can be far too large for one)
+	uint8 bDelta = (bDeltaScary || Mode == ETerminalGridMode::Streamed) ? 1 : 0;
+	Ar << bDelta;
+
+	if (!bDelta)
+	{
+		TBitArray<> Mask = Data.IsValid() ? Data->ScaryMask : TBitArray<>();
+		Ar << Mask;
+		return;
+	}
+
+	// Tiles that gained or lost their scary state compared to the seeded layout
+	TArray<int32> Added;
+	TArray<int32> Removed;
+	GatherScaryChanges(Added, Removed);
+
+	TerminalGridSnapshot::WriteIndexList(Ar, Added);
+	TerminalGridSnapshot::WriteIndexList(Ar, Removed);
+}
+
+/**
+ * Diffs the current scary tiles against the seeded sector layout.
+ */
+void FTerminalGridStore::GatherScaryChanges(TArray<int32>& OutAdded, TArray<int32>& OutRemoved) const
+{
+	OutAdded.Reset();
+	OutRemoved.Reset();
+
+	if (!Data.IsValid())
+	{
+		return;
+	}
+
+	// Streamed grids record exactly these differences already
+	if (Mode == ETerminalGridMode::Streamed)
+	{
+		for (const TPair<int32, bool>& Override : ScaryOverrides)
+		{
+			(Override.Value ? OutAdded : OutRemoved).Add(Override.Key);
+		}
+		return;
+	}
+
+	TArray<int32> BaselinePicks;
+	ComputeSectorScaryPicks(Seed, BaselinePicks);
+	const TSet<int32> Baseline(BaselinePicks);
+
+	Data->ScaryIndex.ForEachTile([this, &Baseline, &OutAdded](int32 X, int32 Y)
+	{
+		const int32 Index = Y * Width + X;
+		if (!Baseline.Contains(Index))
+		{
+			OutAdded.Add(Index);
+		}
+	});
+
+	for (const int32 Index : Baseline)
+	{
+		if (!IsScary(Index))
+		{
+			OutRemoved.Add(Index);
+		}
+	}
+}
+
+/**
+ * Collects the overrides plus every scary change.
+ */
+void FTerminalGridStore::GatherChangedTiles(TArray<int32>& OutIndices) const
+{
+	Overrides.GenerateKeyArray(OutIndices);
+
+	TArray<int32> Added;
+	TArray<int32> Removed;
+	GatherScaryChanges(Added, Removed);
+
+	// Added and Removed never overlap, so only skip tiles already listed as overrides
+	for (const int32 Index : Added)
+	{
+		if (!Overrides.Contains(Index))
+		{
+			OutIndices.Add(Index);
+		}
+	}
+	for (const int32 Index : Removed)
+	{
+		if (!Overrides.Contains(Index))
+		{
+			OutIndices.Add(Index);
+		}
+	}
+}
+
+/**
+ * Applies saved overrides and scary state to the untouched seeded grid.
+ */
+bool FTerminalGridStore::ReadChanges(FArchive& Ar)
+{
+	check(Ar.IsLoading());
+
+	if (TotalCount == 0)
+	{
+		return false;
+	}
+
+	// ========================================
+	// Step 1: Number Overrides
+	// ========================================
+	TArray<int32> OverrideIndices;
+	if (!TerminalGridSnapshot::ReadIndexList(Ar, TotalCount, OverrideIndices))
+	{
+		return false;
+	}
+
+	for (const int32 Index : OverrideIndices)
+	{
+		uint8 Value = 0;
+		Ar << Value;
+		if (Ar.IsError() || Value < 1 || Value > 9)
+		{
+			return false;
+		}
+		SetNumber(Index, Value);
+	}
+
+	// ========================================
+	// Step 2: Scary State
+	// ========================================
+	uint8 bDelta = 0;
+	Ar << bDelta;
+
+	if (!bDelta)
+	{
+		TBitArray<> Mask;
+		Ar << Mask;
+		if (Ar.IsError() || Mask.Num() != TotalCount)
+		{
+			return false;
+		}
+
+		// Clear the seeded layout, then mark every saved tile (keeps the spatial index in sync)
+		TArray<int32> BaselinePicks;
+		ComputeSectorScaryPicks(Seed, BaselinePicks);
+		for (const int32 Index : BaselinePicks)
+		{
+			SetScary(Index, false);
+		}
+		for (TConstSetBitIterator<> It(Mask); It; ++It)
+		{
+			SetScary(It.GetIndex(), true);
+		}
+		return !Ar.IsError();
+	}
+
+	TArray<int32> Added;
+	TArray<int32> Removed;
+	if (!TerminalGridSnapshot::ReadIndexList(Ar, TotalCount, Added)
+		|| !TerminalGridSnapshot::ReadIndexList(Ar, TotalCount, Removed))
+	{
+		return false;
+	}
+
+	for (const int32 Index : Removed)
+	{
+		SetScary(Index, false);
+	}
+	for (const int32 Index : Added)
+	{
+		SetScary(Index, true);
+	}
+	return true;
+}
+
+/**
+ * Reports heap memory owned by the store.
+ */
+SIZE_T FTerminalGridStore::GetAllocatedSize() const
+{
+	SIZE_T Size = Overrides.GetAllocatedSize() + SeededCells.GetAllocatedSize() + ScaryOverrides.GetAllocatedSize() + SectorCache.GetAllocatedSize();
+	if (Data.IsValid())
+	{
+		Size += sizeof(FGridData) + Data->Cells.GetAllocatedSize() + Data->ScaryMask.GetAllocatedSize()
+			+ Data->ScaryIndex.GetAllocatedSize() + Data->ScaryDensity.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,545 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TerminalScaryDensity.h"
+#include "TerminalScaryIndex.h"
+#include "TerminalSectorCache.h"
+#include "TerminalWrap.h"
+#include "TerminalGridStore.generated.h"
+
+/**
+ * How the numbers of the global grid are produced and stored.
+ */
+UENUM(BlueprintType)
+enum class ETerminalGridMode : uint8
+{
+	/** Every cell is rolled up front and stored one byte per cell */
+	Eager,
+
+	/** Cells are computed on demand from the day seed; only eaten tiles are stored */
+	Procedural,
+
+	/**
+	 * Like Procedural, but scary tiles are also implicit and the sectors around the
+	 * view are materialized into a bounded LRU cache. Memory no longer grows with
+	 * the map size, so maps of 10k x 10k and beyond are practical.
+	 */
+	Streamed
+};
+
+/**
+ * Packed storage for a terminal's global number grid.
+ *
+ * The global map is large (1000x1000 by default) but each cell only ever holds
+ * a number from 1 to 9 plus a "scary" flag, so it is stored compactly:
+ * - Numbers are stored one byte per cell (Eager mode), or computed from a
+ *   hash of (seed, cell) with a small override map for eaten tiles (Procedural mode)
+ * - Scary state is stored as one bit per cell, mirrored in a sector-bucketed
+ *   spatial index for fast nearest-scary queries and a per-sector
+ *   summed-area table for density queries
+ *
+ * For the default map this is ~1.1 MB per terminal in Eager mode and ~125 KB
+ * in Procedural mode, instead of ~5 MB for the old TArray<int32> + TArray<bool> layout.
+ *
+ * All accessors take global indices (Y * Width + X). Use ToWrappedIndex to
+ * convert raw coordinates, which may be negative or past the map edges.
+ *
+ * The generated data (cells, scary mask and spatial index) is reference counted
+ * and copy-on-write: copying a store is cheap and shares the data, and the first
+ * write that would change shared data gives the writer its own copy. Procedural
+ * number overrides are always per-store, so eating tiles never copies the map.
+ *
+ * Streamed mode keeps no per-cell data at all: the seeded scary layout is
+ * recomputed per sector, only tiles that differ from the seed are recorded, and
+ * whole sectors are materialized on demand into a cache bounded by a memory
+ * budget (see SetStreamingBudget). Reads update that cache, so a Streamed store
+ * must only be read from one thread at a time.
+ *
+ * Global indices are int32, so a map holds at most 2^31 cells (about 46k x 46k).
+ */
+class PROJECT_REFINEMENT_API FTerminalGridStore
+{
+public:
+	/** Edge length of a map sector in tiles (scary placement and spatial index granularity) */
+	static constexpr int32 SectorSize = 50;
+
+	/** Rows per parallel work item in FillRandomNumbers */
+	static constexpr int32 RowsPerFillBlock = 32;
+
+	/**
+	 * Allocates storage for a Width x Height map.
+	 * In Eager mode all numbers are reset to 0 and must be filled by the caller.
+	 * In Procedural and Streamed mode numbers come from the seed and no cell storage is allocated.
+	 * All scary flags are cleared in every mode.
+	 * Maps past 2^31 cells are shortened to fit.
+	 */
+	void Init(int32 InWidth, int32 InHeight, ETerminalGridMode InMode = ETerminalGridMode::Eager, int32 InSeed = 0);
+
+	/**
+	 * Builds a complete day grid: Init, fill numbers (Eager only) and spawn one
+	 * scary tile per sector, all driven by the seed.
+	 * Touches no UObjects, so it is safe to run on a worker thread.
+	 */
+	void Generate(int32 InWidth, int32 InHeight, ETerminalGridMode InMode, int32 InSeed);
+
+	/**
+	 * Spawns one scary tile at a seeded random position inside every sector
+	 * (keeping 5 tiles away from the sector edges).
+	 * Streamed grids only count them; their seeded layout is implicit.
+	 */
+	void SpawnSectorScaryTiles(int32 InSeed);
+
+	/** Frees all storage. The store reports zero size until Init is called again. */
+	void Reset();
+
+	/** Width of the stored map in cells */
+	int32 GetWidth() const { return Width; }
+
+	/** Height of the stored map in cells */
+	int32 GetHeight() const { return Height; }
+
+	/** Total number of cells in the map */
+	int32 Num() const { return TotalCount; }
+
+	/** Whether a global index refers to a cell of the map */
+	bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < TotalCount; }
+
+	/** How numbers are produced for this map */
+	ETerminalGridMode GetMode() const { return Mode; }
+
+	/** Seed used for Procedural and Streamed numbers */
+	int32 GetSeed() const { return Seed; }
+
+	/** Whether both dimensions are powers of two, so wrapping is a bit mask */
+	bool IsPowerOfTwo() const { return bPowerOfTwo; }
+
+	/**
+	 * Wraps raw grid coordinates onto the map (Pac-Man effect) and
+	 * returns the matching global index.
+	 * Inlines to the mask or the modulo; loops over many tiles should use
+	 * VisitWrap or VisitTiles, which pick the wrap once for the whole loop.
+	 */
+	int32 ToWrappedIndex(int32 X, int32 Y) const
+	{
+		return bPowerOfTwo
+			? ((Y & HeightMask) << WidthShift) | (X & WidthMask)
+			: FTerminalWrapModulo(Height)(Y) * Width + FTerminalWrapModulo(Width)(X);
+	}
+
+	/** Wraps a raw X coordinate onto [0, Width) */
+	int32 WrapX(int32 X) const { return bPowerOfTwo ? X & WidthMask : FTerminalWrapModulo(Width)(X); }
+
+	/** Wraps a raw Y coordinate onto [0, Height) */
+	int32 WrapY(int32 Y) const { return bPowerOfTwo ? Y & HeightMask : FTerminalWrapModulo(Height)(Y); }
+
+	/**
+	 * Calls Func(WrapX, WrapY) with this map's wrap policies (see DispatchTerminalWrap),
+	 * so a loop templated on them wraps every coordinate without a branch.
+	 */
+	template<typename FuncType>
+	decltype(auto) VisitWrap(FuncType&& Func) const
+	{
+		return DispatchTerminalWrap(Width, Height, Forward<FuncType>(Func));
+	}
+
+	/**
+	 * Single-tile reads with the grid mode and wrap fixed at compile time.
+	 * Handed out by VisitTiles; indices must come from Index() (no range checks).
+	 */
+	template<ETerminalGridMode InMode, typename WrapType>
+	class TTileReader
+	{
+	public:
+		TTileReader(const FTerminalGridStore& InStore, const WrapType& InWrapX, const WrapType& InWrapY)
+			: Store(InStore)
+			, WrapX(InWrapX)
+			, WrapY(InWrapY)
+		{
+		}
+
+		/** Global index of raw coordinates (wrapped) */
+		FORCEINLINE int32 Index(int32 X, int32 Y) const
+		{
+			return WrapY(Y) * Store.Width + WrapX(X);
+		}
+
+		/** Same result as GetNumber */
+		FORCEINLINE int32 Number(int32 InIndex) const
+		{
+			if constexpr (InMode == ETerminalGridMode::Eager)
+			{
+				return Store.Data->Cells[InIndex];
+			}
+			else
+			{
+				const uint8* Override = Store.Overrides.Find(InIndex);
+				return Override ? *Override : GetSeededNumber(Store.Seed, InIndex);
+			}
+		}
+
+		/** Same result as IsScary */
+		FORCEINLINE bool Scary(int32 InIndex) const
+		{
+			if constexpr (InMode == ETerminalGridMode::Streamed)
+			{
+				return Store.IsStreamedScary(InIndex);
+			}
+			else
+			{
+				return (bool)Store.Data->ScaryMask[InIndex];
+			}
+		}
+
+	private:
+		const FTerminalGridStore& Store;
+		WrapType WrapX;
+		WrapType WrapY;
+	};
+
+	/**
+	 * Calls Func(Tiles) with a TTileReader for this store's mode and wrap, so a loop
+	 * of single-tile reads (e.g. refilling the viewport) resolves both once instead
+	 * of branching on them per tile like GetNumber / IsScary.
+	 */
+	template<typename FuncType>
+	void VisitTiles(FuncType&& Func) const
+	{
+		VisitWrap([this, &Func](const auto& InWrapX, const auto& InWrapY)
+		{
+			using WrapType = typename TDecay<decltype(InWrapX)>::Type;
+			switch (Mode)
+			{
+			case ETerminalGridMode::Eager:
+				Func(TTileReader<ETerminalGridMode::Eager, WrapType>(*this, InWrapX, InWrapY));
+				break;
+			case ETerminalGridMode::Procedural:
+				Func(TTileReader<ETerminalGridMode::Procedural, WrapType>(*this, InWrapX, InWrapY));
+				break;
+			default:
+				Func(TTileReader<ETerminalGridMode::Streamed, WrapType>(*this, InWrapX, InWrapY));
+				break;
+			}
+		});
+	}
+
+	// ========================================
+	// Numbers
+	// ========================================
+
+	/** Gets the number (1-9) at a global index, or 0 if out of range */
+	int32 GetNumber(int32 Index) const
+	{
+		if (!IsValidIndex(Index))
+		{
+			return 0;
+		}
+
+		if (Mode == ETerminalGridMode::Eager)
+		{
+			return Data->Cells[Index];
+		}
+
+		const uint8* Override = Overrides.Find(Index);
+		return Override ? *Override : GetSeededNumber(Seed, Index);
+	}
+
+	/**
+	 * Eager mode: fills every cell with a random number (1-9) from the given seed.
+	 * Rows are split into blocks filled in parallel, each with its own seeded
+	 * FRandomStream, so the result is the same for a given seed on any machine.
+	 * Does nothing in Procedural mode.
+	 */
+	void FillRandomNumbers(int32 InSeed);
+
+	/**
+	 * Stores a number (1-9) at a global index. Out of range indices are ignored.
+	 * In Procedural and Streamed mode this records an override; writing back the
+	 * seeded value removes the override again.
+	 */
+	void SetNumber(int32 Index, int32 Value);
+
+	/**
+	 * Deterministic number (1-9) for a cell, computed from the seed and global index.
+	 * Counter-based, so any cell can be evaluated independently in O(1).
+	 */
+	static int32 GetSeededNumber(int32 InSeed, int32 Index)
+	{
+		// SplitMix64 finalizer over (seed, index)
+		uint64 Z = ((uint64)(uint32)InSeed << 32) | (uint32)Index;
+		Z += 0x9E3779B97F4A7C15ull;
+		Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		Z ^= (Z >> 31);
+
+		// Map the top 32 bits onto 1-9 without a division
+		return 1 + (int32)(((Z >> 32) * 9) >> 32);
+	}
+
+	/** Number of recorded overrides (tiles eaten since the grid was generated) */
+	int32 GetOverrideCount() const { return Overrides.Num(); }
+
+	/**
+	 * Rehashes the override and scary change maps without the holes left by
+	 * removed entries and frees their slack. Reads stay the same; meant for idle
+	 * time (e.g. while the terminal sleeps), since it touches every entry.
+	 */
+	void CompactChanges();
+
+	// ========================================
+	// Bulk Reads
+	// ========================================
+
+	/**
+	 * Walks a rectangle row by row as contiguous runs of global indices.
+	 * Calls Func(DestOffset, GlobalIndex, Count) for each run, where DestOffset is
+	 * the run's position in a row-major RectWidth x RectHeight output.
+	 * Wrapping splits a row into at most two runs (more only if the rectangle
+	 * is wider than the map).
+	 */
+	template<typename FuncType>
+	void ForEachRectSpan(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight, FuncType&& Func) const
+	{
+		if (TotalCount == 0 || RectWidth <= 0 || RectHeight <= 0)
+		{
+			return;
+		}
+
+		const int32 WrappedStartX = WrapX(StartX);
+
+		for (int32 Row = 0; Row < RectHeight; ++Row)
+		{
+			const int32 RowStart = ToWrappedIndex(0, StartY + Row);
+			int32 DestOffset = Row * RectWidth;
+			int32 X = WrappedStartX;
+			int32 Remaining = RectWidth;
+
+			while (Remaining > 0)
+			{
+				const int32 Count = FMath::Min(Remaining, Width - X);
+				Func(DestOffset, RowStart + X, Count);
+
+				DestOffset += Count;
+				Remaining -= Count;
+				X = 0; // Continue from the left edge after the seam
+			}
+		}
+	}
+
+	/** Reads Count consecutive numbers starting at a global index (must not cross the end of a row) */
+	void ReadNumbers(int32 StartIndex, int32 Count, int32* OutNumbers) const;
+
+	/** Reads Count consecutive scary flags starting at a global index (must not cross the end of a row) */
+	void ReadScary(int32 StartIndex, int32 Count, bool* OutScary) const;
+
+	// ========================================
+	// Scary Mask
+	// ========================================
+
+	/** Whether the tile at a global index is scary, false if out of range */
+	bool IsScary(int32 Index) const
+	{
+		if (!IsValidIndex(Index))
+		{
+			return false;
+		}
+
+		return Mode == ETerminalGridMode::Streamed ? IsStreamedScary(Index) : (bool)Data->ScaryMask[Index];
+	}
+
+	/** Sets or clears the scary flag at a global index. Out of range indices are ignored. */
+	void SetScary(int32 Index, bool bScary);
+
+	/** Number of tiles currently flagged as scary */
+	int32 GetScaryCount() const { return Data.IsValid() ? Data->ScaryCount : 0; }
+
+	/**
+	 * Spatial index of all scary tiles, kept in sync by SetScary (the store must be initialized).
+	 * Empty in Streamed mode; use FindNearestScary to query any mode.
+	 */
+	const FTerminalScaryIndex& GetScaryIndex() const { check(Data.IsValid()); return Data->ScaryIndex; }
+
+	/**
+	 * Finds the scary tile closest to a point, in any mode.
+	 * Eager and Procedural grids switch to a dense scan of the scary mask when the
+	 * sectors around the point are crowded (see FTerminalSensorKernel).
+	 * Streamed grids search the sectors overlapping the radius through the sector cache.
+	 *
+	 * @param CenterX - X of the query point in tiles (any value, wraps automatically)
+	 * @param CenterY - Y of the query point in tiles (any value, wraps automatically)
+	 * @param MaxDistance - Search radius in tiles; tiles at or beyond it are ignored
+	 * @param OutDistanceSquared - Squared distance to the closest tile when found
+	 * @return true if a scary tile lies within MaxDistance
+	 */
+	bool FindNearestScary(float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared) const;
+
+	/**
+	 * Per-sector scary counts of the whole map, kept in sync by SetScary in every mode
+	 * (the store must be initialized). Use it for minimaps and "scary tiles within R" queries.
+	 */
+	const FTerminalScaryDensity& GetScaryDensity() const { check(Data.IsValid()); return Data->ScaryDensity; }
+
+	/** Heap memory used by this store, in bytes (shared data is counted in full) */
+	SIZE_T GetAllocatedSize() const;
+
+	// ========================================
+	// Streaming
+	// ========================================
+
+	/**
+	 * Sets the memory budget of the Streamed sector cache and drops the cached sectors.
+	 * Kept across Init, so it can be applied before or after the grid is generated.
+	 */
+	void SetStreamingBudget(SIZE_T BudgetBytes);
+
+	/**
+	 * Streamed mode: materializes the sectors overlapping a raw (unwrapped) tile
+	 * rectangle and marks them as recently used, so the view and sensor stay resident.
+	 * Does nothing in the other modes.
+	 */
+	void PrefetchSectors(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const;
+
+	/** Streamed mode: drops every cached sector (they are rebuilt on the next read) */
+	void ReleaseSectors() { SectorCache.Empty(); }
+
+	/** Number of sectors currently materialized in the Streamed cache */
+	int32 GetResidentSectorCount() const { return SectorCache.Num(); }
+
+	// ========================================
+	// Sharing
+	// ========================================
+
+	/** Whether the generated data is also referenced by another store */
+	bool IsDataShared() const { return Data.IsValid() && !Data.IsUnique(); }
+
+	/** Whether nothing was written since the grid was generated (or copied from a pristine store) */
+	bool IsPristine() const { return !bLocalWrites; }
+
+	// ========================================
+	// Snapshots
+	// ========================================
+
+	/**
+	 * Writes everything that changed since the grid was generated from its seed:
+	 * the number overrides and the scary state.
+	 * Indices are sorted and stored as packed deltas, so a mid-day grid is a few KB.
+	 *
+	 * @param Ar - Archive to write to
+	 * @param bDeltaScary - Store only scary tiles added/removed vs the seed layout,
+	 *                      instead of the full one-bit-per-cell mask
+	 */
+	void WriteChanges(FArchive& Ar, bool bDeltaScary) const;
+
+	/**
+	 * Applies changes written by WriteChanges.
+	 * The store must hold the untouched grid for the same seed, size and mode.
+	 *
+	 * @return false if the data is malformed (the store may be partly updated)
+	 */
+	bool ReadChanges(FArchive& Ar);
+
+	/** Global indices of the scary tiles SpawnSectorScaryTiles places for a seed */
+	void ComputeSectorScaryPicks(int32 InSeed, TArray<int32>& OutPicks) const;
+
+	/**
+	 * Global index of the seeded scary tile of one sector.
+	 * Picks in partial edge sectors are clamped, so every pick stays inside its own
+	 * sector and the layout is the same in every mode.
+	 */
+	int32 GetSectorScaryPick(int32 InSeed, int32 SectorIndex) const;
+
+	/** Scary tiles gained and lost compared to the seeded layout (unsorted) */
+	void GatherScaryChanges(TArray<int32>& OutAdded, TArray<int32>& OutRemoved) const;
+
+	/** Every tile whose number or scary state differs from the seeded grid (unsorted, unique) */
+	void GatherChangedTiles(TArray<int32>& OutIndices) const;
+
+private:
+	/** Generated grid contents, shared between copies of a store until one of them writes */
+	struct FGridData
+	{
+		/** Eager mode: one byte per cell, values 1-9 */
+		TArray<uint8> Cells;
+
+		/** One bit per cell, set when the tile is scary */
+		TBitArray<> ScaryMask;
+
+		/** Cached population count of ScaryMask */
+		int32 ScaryCount = 0;
+
+		/** Sector buckets of scary tile coordinates */
+		FTerminalScaryIndex ScaryIndex;
+
+		/** Scary tiles per sector as a summed-area table (all modes) */
+		FTerminalScaryDensity ScaryDensity;
+	};
+
+	/** Sector containing a global index */
+	int32 GetSectorIndex(int32 Index) const
+	{
+		return ((Index / Width) / SectorSize) * SectorsX + (Index % Width) / SectorSize;
+	}
+
+	/** Streamed IsScary: resident sector, then recorded change, then the seeded pick */
+	bool IsStreamedScary(int32 Index) const;
+
+	/** Streamed sector from the cache, materialized from the seed and changes if not resident */
+	const FTerminalSector& GetStreamedSector(int32 SectorIndex) const;
+
+	/** Fills a sector with seeded numbers and scary tiles, then applies the recorded changes */
+	void MaterializeSector(int32 SectorIndex, FTerminalSector& OutSector) const;
+
+	/** Gives this store its own copy of the data before a write */
+	FGridData& GetMutableData()
+	{
+		if (!Data.IsUnique())
+		{
+			Data = MakeShared<FGridData, ESPMode::ThreadSafe>(*Data);
+		}
+		return *Data;
+	}
+
+	/** Map dimensions in cells */
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 TotalCount = 0;
+
+	/** Map dimensions in sectors (the last row/column may be partial) */
+	int32 SectorsX = 0;
+	int32 SectorsY = 0;
+
+	/** Power-of-two fast path: masks and shift for the map size (unused otherwise) */
+	bool bPowerOfTwo = false;
+	int32 WidthMask = 0;
+	int32 HeightMask = 0;
+	int32 WidthShift = 0;
+
+	/** How numbers are produced */
+	ETerminalGridMode Mode = ETerminalGridMode::Eager;
+
+	/** Seed for Procedural and Streamed numbers */
+	int32 Seed = 0;
+
+	/** Cells, scary mask and spatial index (null until Init) */
+	TSharedPtr<FGridData, ESPMode::ThreadSafe> Data;
+
+	/**
+	 * Numbers that differ from the seeded value (eaten tiles), in every mode.
+	 * Eager cells live in Data; the copy here lets snapshots store just the changes.
+	 */
+	TMap<int32, uint8> Overrides;
+
+	/**
+	 * Eager mode: generated value of every overridden cell, so writing it back drops the override.
+	 * The Eager fill runs one stream per row block, so a single cell can't be re-derived cheaply.
+	 */
+	TMap<int32, uint8> SeededCells;
+
+	/** Streamed mode: tiles whose scary state differs from the seeded layout (true = gained) */
+	TMap<int32, bool> ScaryOverrides;
+
+	/** Streamed mode: materialized sectors around the view (never shared between copies) */
+	mutable FTerminalSectorCache SectorCache;
+
+	/** Set by the first SetNumber/SetScary after the grid was built */
+	bool bLocalWrites = false;
+};
@@ -0,0 +1,179 @@
+#include "TerminalGridTexture.h"
+#include "Engine/Texture2D.h"
+#include "RHI.h"
+
+/**
+ * Creates the texture; contents are uploaded by the first Flush.
+ */
+UTexture2D* FTerminalGridTexture::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(InWidth, 1);
+	Height = FMath::Max(InHeight, 1);
+	RingX = 0;
+	RingY = 0;
+	Texels.Init(0, Width * Height);
+	DirtyRegions.Reset();
+	bFullUpload = true;
+	bValid = false;
+
+	// Single channel 8-bit, sampled as raw values: no filtering, no sRGB curve, no mips
+	UTexture2D* NewTexture = UTexture2D::CreateTransient(Width, Height, PF_G8);
+	if (NewTexture)
+	{
+		NewTexture->Filter = TF_Nearest;
+		NewTexture->SRGB = false;
+		NewTexture->AddressX = TA_Wrap;
+		NewTexture->AddressY = TA_Wrap;
+		NewTexture->LODGroup = TEXTUREGROUP_Pixels2D;
+		NewTexture->UpdateResource();
+	}
+
+	Texture = NewTexture;
+	return NewTexture;
+}
+
+/**
+ * Frees the CPU copy; the next refill re-creates it at the same size.
+ */
+void FTerminalGridTexture::ReleaseTexels()
+{
+	Texels.Empty();
+	DirtyRegions.Reset();
+	bFullUpload = false;
+	bValid = false;
+}
+
+/**
+ * Moves the ring origin; wrap addressing in the material does the rest.
+ */
+void FTerminalGridTexture::Scroll(int32 ShiftX, int32 ShiftY)
+{
+	RingX = ((RingX + ShiftX) % Width + Width) % Width;
+	RingY = ((RingY + ShiftY) % Height + Height) % Height;
+}
+
+/**
+ * Writes one texel, re-creating the CPU copy if it was released.
+ */
+void FTerminalGridTexture::SetTexel(int32 WindowX, int32 WindowY, uint8 Value)
+{
+	if (Texels.Num() != Width * Height)
+	{
+		Texels.Init(0, Width * Height);
+		bFullUpload = true;
+	}
+
+	Texels[GetTexelIndex(WindowX, WindowY)] = Value;
+}
+
+/**
+ * Writes one texel and queues it for upload if it changed.
+ */
+void FTerminalGridTexture::UpdateTexel(int32 WindowX, int32 WindowY, uint8 Value)
+{
+	if (Texels.Num() != Width * Height)
+	{
+		return;
+	}
+
+	const int32 TexelIndex = GetTexelIndex(WindowX, WindowY);
+	if (Texels[TexelIndex] != Value)
+	{
+		Texels[TexelIndex] = Value;
+		AddDirtyRegion(TexelIndex % Width, TexelIndex / Width, 1, 1);
+	}
+}
+
+/**
+ * A window rectangle maps to up to four texel rectangles once the ring wraps.
+ */
+void FTerminalGridTexture::MarkDirty(int32 WindowX, int32 WindowY, int32 RectWidth, int32 RectHeight)
+{
+	if (RectWidth <= 0 || RectHeight <= 0)
+	{
+		return;
+	}
+
+	const int32 StartX = (WindowX + RingX) % Width;
+	const int32 StartY = (WindowY + RingY) % Height;
+	const int32 FirstWidth = FMath::Min(RectWidth, Width - StartX);
+	const int32 FirstHeight = FMath::Min(RectHeight, Height - StartY);
+
+	AddDirtyRegion(StartX, StartY, FirstWidth, FirstHeight);
+	if (FirstWidth < RectWidth)
+	{
+		AddDirtyRegion(0, StartY, RectWidth - FirstWidth, FirstHeight);
+	}
+	if (FirstHeight < RectHeight)
+	{
+		AddDirtyRegion(StartX, 0, FirstWidth, RectHeight - FirstHeight);
+		if (FirstWidth < RectWidth)
+		{
+			AddDirtyRegion(0, 0, RectWidth - FirstWidth, RectHeight - FirstHeight);
+		}
+	}
+}
+
+/**
+ * Queues a texel rectangle for upload.
+ */
+void FTerminalGridTexture::AddDirtyRegion(int32 TexelX, int32 TexelY, int32 RegionWidth, int32 RegionHeight)
+{
+	if (bFullUpload)
+	{
+		return;
+	}
+
+	// Past a handful of regions a single full upload is cheaper (the window is only a few hundred bytes)
+	if (DirtyRegions.Num() >= MaxDirtyRegions)
+	{
+		bFullUpload = true;
+		DirtyRegions.Reset();
+		return;
+	}
+
+	DirtyRegions.Add(FIntRect(TexelX, TexelY, TexelX + RegionWidth, TexelY + RegionHeight));
+}
+
+/**
+ * Hands the dirty regions to the render thread.
+ * The render thread reads after this returns, so it gets its own copies of the
+ * regions and texels and frees them when the copy is done.
+ */
+void FTerminalGridTexture::Flush()
+{
+	UTexture2D* TargetTexture = Texture.Get();
+	if (!TargetTexture || Texels.Num() != Width * Height || (!bFullUpload && DirtyRegions.Num() == 0))
+	{
+		return;
+	}
+
+	const int32 NumRegions = bFullUpload ? 1 : DirtyRegions.Num();
+	FUpdateTextureRegion2D* Regions = new FUpdateTextureRegion2D[NumRegions];
+
+	if (bFullUpload)
+	{
+		Regions[0] = FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height);
+	}
+	else
+	{
+		for (int32 i = 0; i < NumRegions; ++i)
+		{
+			const FIntRect& Rect = DirtyRegions[i];
+			Regions[i] = FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, Rect.Min.X, Rect.Min.Y, Rect.Width(), Rect.Height());
+		}
+	}
+
+	uint8* SourceData = (uint8*)FMemory::Malloc(Texels.Num());
+	FMemory::Memcpy(SourceData, Texels.GetData(), Texels.Num());
+
+	TargetTexture->UpdateTextureRegions(0, NumRegions, Regions, Width, 1, SourceData,
+		[](uint8* InSourceData, const FUpdateTextureRegion2D* InRegions)
+		{
+			FMemory::Free(InSourceData);
+			delete[] InRegions;
+		});
+
+	DirtyRegions.Reset();
+	bFullUpload = false;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+/**
+ * Bit layout of one grid texel, decoded by the screen material as round(Texel.r * 255).
+ */
+namespace TerminalGridTexel
+{
+	/** Bits 0-3: the digit (1-9, 0 = no tile) */
+	static constexpr uint8 DigitMask = 0x0F;
+
+	/** Bit 4: the tile is scary */
+	static constexpr uint8 Scary = 0x10;
+
+	/** Bit 5: the digit is prime */
+	static constexpr uint8 Prime = 0x20;
+
+	/** Packs a tile into a texel */
+	inline uint8 Pack(int32 Number, bool bScary, bool bPrime)
+	{
+		return (uint8)(Number & DigitMask) | (bScary ? Scary : 0) | (bPrime ? Prime : 0);
+	}
+}
+
+/**
+ * One-byte-per-tile texture of the visible window plus a border, for drawing
+ * the grid with a digit-atlas material instead of one text widget per tile.
+ *
+ * The texels are a ring buffer in both axes, like the actor's viewport ring:
+ * scrolling rotates the ring and only the rows and columns that entered the
+ * window are rewritten and uploaded. The material samples with wrap addressing
+ * from the ring origin, so the rotation (and sub-tile scrolling) is just a UV offset.
+ *
+ * Changes are collected as texture regions and sent to the GPU in one
+ * UpdateTextureRegions call per Flush.
+ */
+class PROJECT_REFINEMENT_API FTerminalGridTexture
+{
+public:
+	/** More dirty regions than this upload the whole texture instead */
+	static constexpr int32 MaxDirtyRegions = 16;
+
+	/**
+	 * Creates a Width x Height single channel texture (nearest filtering, wrap addressing)
+	 * and marks every texel dirty. The caller keeps the texture referenced.
+	 */
+	UTexture2D* Init(int32 InWidth, int32 InHeight);
+
+	/** Drops the CPU texels; the texture keeps its last contents until Init or a full refill */
+	void ReleaseTexels();
+
+	/** Whether the texels hold the current window */
+	bool IsValid() const { return bValid; }
+
+	/** Marks the texels as holding the current window (after a full refill) */
+	void MarkValid() { bValid = true; }
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+	/** Texel column holding window column 0 */
+	int32 GetRingX() const { return RingX; }
+
+	/** Texel row holding window row 0 */
+	int32 GetRingY() const { return RingY; }
+
+	/**
+	 * Rotates the ring for a scroll of ShiftX/ShiftY tiles.
+	 * The rows and columns that entered the window still hold old tiles and must be rewritten.
+	 */
+	void Scroll(int32 ShiftX, int32 ShiftY);
+
+	/**
+	 * Writes one texel at window coordinates (0..Width-1, 0..Height-1) without marking it dirty.
+	 * For bulk writes; call MarkDirty for the written rectangle afterwards.
+	 */
+	void SetTexel(int32 WindowX, int32 WindowY, uint8 Value);
+
+	/** Writes one texel at window coordinates and marks it dirty if it changed */
+	void UpdateTexel(int32 WindowX, int32 WindowY, uint8 Value);
+
+	/** Marks a window rectangle dirty (split at the ring seams as needed) */
+	void MarkDirty(int32 WindowX, int32 WindowY, int32 RectWidth, int32 RectHeight);
+
+	/** Sends the dirty regions to the texture; does nothing if nothing changed */
+	void Flush();
+
+private:
+	/** Texel array index of a window coordinate */
+	int32 GetTexelIndex(int32 WindowX, int32 WindowY) const
+	{
+		return ((WindowY + RingY) % Height) * Width + (WindowX + RingX) % Width;
+	}
+
+	/** Adds a region in texel space, falling back to a full upload when there are too many */
+	void AddDirtyRegion(int32 TexelX, int32 TexelY, int32 RegionWidth, int32 RegionHeight);
+
+	/** Texture being written (owned by the actor's UPROPERTY) */
+	TWeakObjectPtr<UTexture2D> Texture;
+
+	/** CPU copy of the texture, row-major */
+	TArray<uint8> Texels;
+
+	/** Texel rectangles changed since the last Flush (Min inclusive, Max exclusive) */
+	TArray<FIntRect, TInlineAllocator<MaxDirtyRegions>> DirtyRegions;
+
+	/** Set when a Flush must upload every texel */
+	bool bFullUpload = false;
+
+	bool bValid = false;
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 RingX = 0;
+	int32 RingY = 0;
+};
@@ -0,0 +1,396 @@
+#include "TerminalJobScheduler.h"
+#include "Project_Refinement.h"
+#include "TerminalActor.h"
+#include "TerminalStats.h"
+#include "TerminalSubsystem.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarTerminalJobBudgetMs(
+	TEXT("Terminal.JobBudgetMs"),
+	1.0f,
+	TEXT("Milliseconds per frame the terminal job scheduler may spend on queued jobs (at least one slice always runs)"));
+
+static TAutoConsoleVariable<int32> CVarTerminalJobMaxWorkers(
+	TEXT("Terminal.JobMaxWorkers"),
+	2,
+	TEXT("Terminal worker jobs allowed on the thread pool at once"));
+
+/**
+ * Hooks the end-of-frame run.
+ */
+void UTerminalJobScheduler::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UTerminalJobScheduler::HandleWorldPostActorTick);
+}
+
+/**
+ * Drops every job; the world is going away.
+ * Workers already running keep their own copies of what they build and finish on their own.
+ */
+void UTerminalJobScheduler::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+
+	Jobs.Empty();
+	SET_DWORD_STAT(STAT_TerminalJobsPending, 0);
+
+	Super::Deinitialize();
+}
+
+// ========================================
+// QUEUEING
+// ========================================
+
+/**
+ * Game-thread job: only the slice is needed.
+ */
+FTerminalJobHandle UTerminalJobScheduler::QueueJob(const ATerminalActor* Owner, FName Name, ETerminalJobPriority Priority, FTerminalJobSlice&& Slice)
+{
+	check(Slice);
+
+	TUniquePtr<FJob> Job = MakeUnique<FJob>();
+	Job->Owner = Owner;
+	Job->bHasOwner = Owner != nullptr;
+	Job->Name = Name;
+	Job->Priority = Priority;
+	Job->Slice = MoveTemp(Slice);
+	return AddJob(MoveTemp(Job));
+}
+
+/**
+ * Worker job: the work waits for a free worker slot, the completion for the budget.
+ */
+FTerminalJobHandle UTerminalJobScheduler::QueueWorkerJob(const ATerminalActor* Owner, FName Name, ETerminalJobPriority Priority,
+	TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnComplete)
+{
+	check(Work);
+
+	TUniquePtr<FJob> Job = MakeUnique<FJob>();
+	Job->Owner = Owner;
+	Job->bHasOwner = Owner != nullptr;
+	Job->Name = Name;
+	Job->Priority = Priority;
+	Job->bWorker = true;
+	Job->Work = MoveTemp(Work);
+	Job->OnComplete = MoveTemp(OnComplete);
+	return AddJob(MoveTemp(Job));
+}
+
+/**
+ * Jobs queued while the queue is running wait for the next frame.
+ */
+FTerminalJobHandle UTerminalJobScheduler::AddJob(TUniquePtr<FJob>&& Job)
+{
+	FTerminalJobHandle Handle;
+	Handle.Id = NextJobId++;
+	Job->Id = Handle.Id;
+
+	Jobs.Add(MoveTemp(Job));
+	SET_DWORD_STAT(STAT_TerminalJobsPending, Jobs.Num());
+	return Handle;
+}
+
+/**
+ * Marks the job finished. A slice may cancel its own job, so the entry
+ * (and the callable running right now) stays until the queue walk is over.
+ */
+bool UTerminalJobScheduler::CancelJob(FTerminalJobHandle& Handle)
+{
+	bool bCancelled = false;
+	if (Handle.IsValid())
+	{
+		for (const TUniquePtr<FJob>& Job : Jobs)
+		{
+			if (Job->Id == Handle.Id && !Job->bFinished)
+			{
+				Job->bFinished = true;
+				bCancelled = true;
+				break;
+			}
+		}
+	}
+
+	Handle.Reset();
+	if (bCancelled && !bRunning)
+	{
+		RemoveFinishedJobs();
+	}
+	return bCancelled;
+}
+
+/**
+ * Cancels by owner, same rules as CancelJob.
+ */
+void UTerminalJobScheduler::CancelJobs(const ATerminalActor* Owner)
+{
+	for (const TUniquePtr<FJob>& Job : Jobs)
+	{
+		if (Job->bHasOwner && Job->Owner.Get() == Owner)
+		{
+			Job->bFinished = true;
+		}
+	}
+
+	if (!bRunning)
+	{
+		RemoveFinishedJobs();
+	}
+}
+
+/**
+ * Linear search; the queue holds a handful of jobs per terminal.
+ */
+bool UTerminalJobScheduler::IsJobQueued(FTerminalJobHandle Handle) const
+{
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+
+	for (const TUniquePtr<FJob>& Job : Jobs)
+	{
+		if (Job->Id == Handle.Id)
+		{
+			return !Job->bFinished;
+		}
+	}
+	return false;
+}
+
+// ========================================
+// RUNNING
+// ========================================
+
+/**
+ * End of frame: run the queue with the configured budget.
+ */
+void UTerminalJobScheduler::HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (InWorld == GetWorld())
+	{
+		RunJobs(FMath::Max(CVarTerminalJobBudgetMs.GetValueOnGameThread(), 0.f) / 1000.0);
+	}
+}
+
+/**
+ * Runs slices and worker completions in run order until the budget is used up.
+ */
+void UTerminalJobScheduler::RunJobs(double BudgetSeconds)
+{
+	if (bRunning || Jobs.Num() == 0)
+	{
+		LastRunMilliseconds = 0.0;
+		return;
+	}
+
+	TERMINAL_SCOPE_CYCLE_COUNTER(STAT_TerminalRunJobs, "Terminal.RunJobs");
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + BudgetSeconds;
+	FName LastJobName = NAME_None;
+	int32 Slices = 0;
+
+	{
+		TGuardValue<bool> RunningGuard(bRunning, true);
+
+		TArray<FJob*> Order;
+		GatherRunOrder(Order);
+		StartWorkers(Order, FMath::Max(CVarTerminalJobMaxWorkers.GetValueOnGameThread(), 1));
+
+		for (FJob* Job : Order)
+		{
+			// Finished or cancelled by an earlier slice this frame
+			if (Job->bFinished)
+			{
+				continue;
+			}
+
+			// Workers that haven't started or are still busy cost nothing here
+			if (Job->bWorker && (!Job->WorkerResult.IsValid() || !Job->WorkerResult.IsReady()))
+			{
+				continue;
+			}
+
+			// The first slice always runs, so a budget smaller than any slice still makes progress
+			if (Slices > 0 && FPlatformTime::Seconds() >= Deadline)
+			{
+				break;
+			}
+
+			++Slices;
+			LastJobName = Job->Name;
+
+			if (Job->bWorker)
+			{
+				// Finished before the callback, so it can queue a follow-up under a new handle
+				Job->bFinished = true;
+				if (Job->OnComplete)
+				{
+					Job->OnComplete();
+				}
+			}
+			else if (Job->Slice(Deadline))
+			{
+				Job->bFinished = true;
+			}
+		}
+	}
+
+	RemoveFinishedJobs();
+
+	// ========================================
+	// Budget Report
+	// ========================================
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	LastRunMilliseconds = Elapsed * 1000.0;
+	INC_DWORD_STAT_BY(STAT_TerminalJobSlices, Slices);
+
+	if (Slices > 0 && Elapsed > BudgetSeconds)
+	{
+		++BudgetOverrunCount;
+		INC_DWORD_STAT(STAT_TerminalJobBudgetOverruns);
+		UE_LOG(LogTerminal, Verbose, TEXT("Terminal jobs took %.3f ms (budget %.3f ms, %d slices, last job %s)"),
+			LastRunMilliseconds, BudgetSeconds * 1000.0, Slices, *LastJobName.ToString());
+	}
+}
+
+/**
+ * Ignores the budget: starts every worker, waits for it and runs slices until each job reports done.
+ * Jobs queued by completions and slices are picked up by the next pass.
+ */
+void UTerminalJobScheduler::FlushJobs()
+{
+	if (bRunning)
+	{
+		return;
+	}
+
+	while (Jobs.Num() > 0)
+	{
+		{
+			TGuardValue<bool> RunningGuard(bRunning, true);
+
+			TArray<FJob*> Order;
+			GatherRunOrder(Order);
+			StartWorkers(Order, MAX_int32);
+
+			for (FJob* Job : Order)
+			{
+				if (Job->bWorker)
+				{
+					if (Job->WorkerResult.IsValid())
+					{
+						Job->WorkerResult.Wait();
+					}
+					if (!Job->bFinished)
+					{
+						Job->bFinished = true;
+						if (Job->OnComplete)
+						{
+							Job->OnComplete();
+						}
+					}
+					continue;
+				}
+
+				while (!Job->bFinished)
+				{
+					Job->bFinished = Job->Slice(MAX_dbl) || Job->bFinished;
+				}
+			}
+
+			// Cancelled workers may still be running - their entries go once they're done
+			for (const TUniquePtr<FJob>& Job : Jobs)
+			{
+				if (Job->bFinished && Job->WorkerResult.IsValid())
+				{
+					Job->WorkerResult.Wait();
+				}
+			}
+		}
+
+		RemoveFinishedJobs();
+	}
+}
+
+/**
+ * Seated terminal first, then priority; the sort is stable so ties keep queue order.
+ */
+void UTerminalJobScheduler::GatherRunOrder(TArray<FJob*>& OutOrder)
+{
+	const UTerminalSubsystem* TerminalManager = GetWorld() ? GetWorld()->GetSubsystem<UTerminalSubsystem>() : nullptr;
+	const ATerminalActor* ActiveTerminal = TerminalManager ? TerminalManager->GetActiveTerminal() : nullptr;
+
+	OutOrder.Reset(Jobs.Num());
+	for (const TUniquePtr<FJob>& Job : Jobs)
+	{
+		// The terminal is gone, nobody wants the result
+		if (Job->bHasOwner && !Job->Owner.IsValid())
+		{
+			Job->bFinished = true;
+		}
+
+		if (!Job->bFinished)
+		{
+			OutOrder.Add(Job.Get());
+		}
+	}
+
+	OutOrder.StableSort([ActiveTerminal](const FJob& A, const FJob& B)
+	{
+		const bool bActiveA = ActiveTerminal && A.Owner.Get() == ActiveTerminal;
+		const bool bActiveB = ActiveTerminal && B.Owner.Get() == ActiveTerminal;
+		if (bActiveA != bActiveB)
+		{
+			return bActiveA;
+		}
+		return A.Priority < B.Priority;
+	});
+}
+
+/**
+ * Worker slots are counted from the futures, so a slot frees up as soon as its work returns.
+ */
+void UTerminalJobScheduler::StartWorkers(TConstArrayView<FJob*> Order, int32 MaxWorkers)
+{
+	int32 RunningWorkers = 0;
+	for (const TUniquePtr<FJob>& Job : Jobs)
+	{
+		if (Job->WorkerResult.IsValid() && !Job->WorkerResult.IsReady())
+		{
+			++RunningWorkers;
+		}
+	}
+
+	for (FJob* Job : Order)
+	{
+		if (RunningWorkers >= MaxWorkers)
+		{
+			break;
+		}
+
+		if (Job->bWorker && !Job->bFinished && !Job->WorkerResult.IsValid())
+		{
+			Job->WorkerResult = Async(EAsyncExecution::ThreadPool, MoveTemp(Job->Work));
+			++RunningWorkers;
+		}
+	}
+}
+
+/**
+ * An entry whose worker is still running stays, so the worker slot stays counted.
+ */
+void UTerminalJobScheduler::RemoveFinishedJobs()
+{
+	Jobs.RemoveAll([](const TUniquePtr<FJob>& Job)
+	{
+		return Job->bFinished && (!Job->WorkerResult.IsValid() || Job->WorkerResult.IsReady());
+	});
+
+	SET_DWORD_STAT(STAT_TerminalJobsPending, Jobs.Num());
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Async/Future.h"
+#include "TerminalJobScheduler.generated.h"
+
+class ATerminalActor;
+
+/** Order in which queued jobs run; the seated terminal's jobs always go first */
+UENUM(BlueprintType)
+enum class ETerminalJobPriority : uint8
+{
+	/** Work the player is about to see */
+	High,
+
+	/** Warm-up work that makes the next moments cheaper */
+	Normal,
+
+	/** Housekeeping that can wait for idle frames */
+	Low
+};
+
+/** Identifies a queued job. Default-constructed handles refer to no job. */
+struct FTerminalJobHandle
+{
+	uint64 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Reset() { Id = 0; }
+};
+
+/**
+ * One slice of a game-thread job.
+ * Gets the FPlatformTime::Seconds() it should return by, and returns true once the job is done.
+ * Jobs keep their progress in the callable, so a slice picks up where the last one stopped.
+ */
+using FTerminalJobSlice = TUniqueFunction<bool(double DeadlineSeconds)>;
+
+/**
+ * Terminal Job Scheduler - frame-budgeted maintenance work for terminals.
+ *
+ * Work that is too big for one frame but not urgent (warming Streamed sectors,
+ * compacting a sleeping terminal's changes, building tomorrow's map) is queued
+ * here instead of running in one burst. After all actors have ticked the
+ * scheduler runs jobs until the frame budget (Terminal.JobBudgetMs) is used up:
+ * - Jobs owned by the seated terminal first, then by priority, then in queue order
+ * - Game-thread jobs run in slices and resume next frame where they stopped
+ * - Worker jobs run on the thread pool (at most Terminal.JobMaxWorkers at a time);
+ *   their completion callback runs on the game thread inside the budget
+ * - At least one slice runs every frame, so a long slice can't starve the queue
+ *
+ * Frames that go over budget count in the "Job Budget Overruns" stat and are logged
+ * (LogTerminal, Verbose) with the job that ran last. Jobs whose owner was destroyed
+ * are dropped.
+ */
+UCLASS()
+class PROJECT_REFINEMENT_API UTerminalJobScheduler : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// ========================================
+	// Queueing
+	// ========================================
+
+	/**
+	 * Queues a game-thread job that runs in slices within the frame budget.
+	 *
+	 * @param Owner - Terminal the work is for (drops the job when destroyed), or nullptr
+	 * @param Name - Shown in overrun logs
+	 * @param Slice - Called once per frame until it returns true
+	 */
+	FTerminalJobHandle QueueJob(const ATerminalActor* Owner, FName Name, ETerminalJobPriority Priority, FTerminalJobSlice&& Slice);
+
+	/**
+	 * Queues a job that runs on the thread pool. Work must not touch UObjects.
+	 *
+	 * @param Owner - Terminal the work is for (drops the result when destroyed), or nullptr
+	 * @param Name - Shown in overrun logs
+	 * @param Work - Runs on a worker once a worker slot is free
+	 * @param OnComplete - Runs on the game thread after Work, unless the job was cancelled
+	 */
+	FTerminalJobHandle QueueWorkerJob(const ATerminalActor* Owner, FName Name, ETerminalJobPriority Priority,
+		TUniqueFunction<void()>&& Work, TUniqueFunction<void()>&& OnComplete);
+
+	/**
+	 * Cancels a job and resets the handle. A worker job that already started
+	 * finishes its Work, but OnComplete is not called.
+	 *
+	 * @return true if the job was still queued
+	 */
+	bool CancelJob(FTerminalJobHandle& Handle);
+
+	/** Cancels every job of a terminal */
+	void CancelJobs(const ATerminalActor* Owner);
+
+	/** Whether a job is waiting, running or waiting for its completion callback */
+	bool IsJobQueued(FTerminalJobHandle Handle) const;
+
+	// ========================================
+	// Running
+	// ========================================
+
+	/**
+	 * Runs jobs for up to BudgetSeconds (at least one slice).
+	 * Called at the end of every frame with the Terminal.JobBudgetMs budget.
+	 */
+	void RunJobs(double BudgetSeconds);
+
+	/** Runs every queued job to completion, waiting for workers (e.g. before a benchmark pass) */
+	void FlushJobs();
+
+	/** Jobs not finished yet */
+	int32 GetPendingJobCount() const { return Jobs.Num(); }
+
+	/** Time RunJobs took last frame, in milliseconds */
+	double GetLastRunMilliseconds() const { return LastRunMilliseconds; }
+
+	/** Frames whose jobs went over the budget since the world started */
+	int32 GetBudgetOverrunCount() const { return BudgetOverrunCount; }
+
+private:
+	struct FJob
+	{
+		uint64 Id = 0;
+		TWeakObjectPtr<const ATerminalActor> Owner;
+		bool bHasOwner = false;
+		FName Name;
+		ETerminalJobPriority Priority = ETerminalJobPriority::Normal;
+
+		/** Game-thread jobs */
+		FTerminalJobSlice Slice;
+
+		/** Worker jobs: the work, its result and the game-thread callback */
+		bool bWorker = false;
+		TUniqueFunction<void()> Work;
+		TUniqueFunction<void()> OnComplete;
+		TFuture<void> WorkerResult;
+
+		/** Set by CancelJob and on completion; the entry is removed once no worker uses it */
+		bool bFinished = false;
+	};
+
+	/** Adds a job to the queue and returns its handle */
+	FTerminalJobHandle AddJob(TUniquePtr<FJob>&& Job);
+
+	/** Marks jobs of destroyed owners finished and returns the rest in run order */
+	void GatherRunOrder(TArray<FJob*>& OutOrder);
+
+	/** Starts worker jobs (in run order) until MaxWorkers are running */
+	void StartWorkers(TConstArrayView<FJob*> Order, int32 MaxWorkers);
+
+	/** Removes finished jobs that no worker still references */
+	void RemoveFinishedJobs();
+
+	/** End-of-frame hook (FWorldDelegates::OnWorldPostActorTick) */
+	void HandleWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+	/** Queued jobs, in queue order */
+	TArray<TUniquePtr<FJob>> Jobs;
+
+	/** Id of the next job (0 is never used) */
+	uint64 NextJobId = 1;
+
+	/** Set while RunJobs or FlushJobs walks the queue */
+	bool bRunning = false;
+
+	double LastRunMilliseconds = 0.0;
+	int32 BudgetOverrunCount = 0;
+
+	FDelegateHandle PostActorTickHandle;
+};
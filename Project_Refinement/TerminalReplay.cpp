@@ -0,0 +1,353 @@
+#include "TerminalReplay.h"
+#include "Project_Refinement.h"
+#include "TerminalActor.h"
+#include "Engine/World.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+// ========================================
+// RECORDER
+// ========================================
+
+/**
+ * Writes the header.
+ *
+ * Layout (little-endian, see FArchive):
+ * - Header: magic, version
+ * - Start state: terminal snapshot (length-prefixed), RNG seed, sub-tile X/Y, pending chunk
+ * - Records: tag (uint8), packed delta ms, payload
+ */
+FTerminalRecorder::FTerminalRecorder(const ATerminalActor& Terminal)
+	: World(Terminal.GetWorld())
+{
+	TArray<uint8> Snapshot;
+	Terminal.WriteSnapshot(Snapshot);
+
+	FMemoryWriter Ar(Data);
+	uint32 Magic = TerminalReplay::Magic;
+	int32 Version = (int32)TerminalReplay::EVersion::Latest;
+	int32 RandomSeed = Terminal.GridRandomStream.GetCurrentSeed();
+	float AccumulatorX = Terminal.AccumulatorX;
+	float AccumulatorY = Terminal.AccumulatorY;
+	float PendingChunkValue = Terminal.PendingChunkValue;
+	Ar << Magic << Version << Snapshot << RandomSeed << AccumulatorX << AccumulatorY << PendingChunkValue;
+
+	StartTime = World.IsValid() ? World->GetTimeSeconds() : 0.0;
+}
+
+/**
+ * Delta times are packed, so records a frame apart take a single byte for the time.
+ */
+void FTerminalRecorder::BeginRecord(FArchive& Ar, TerminalReplay::ERecord Type)
+{
+	const double Now = World.IsValid() ? World->GetTimeSeconds() : StartTime;
+	const uint32 TimeMs = FMath::Max((uint32)FMath::Max((Now - StartTime) * 1000.0, 0.0), LastTimeMs);
+
+	uint8 Tag = (uint8)Type;
+	uint32 DeltaMs = TimeMs - LastTimeMs;
+	Ar << Tag;
+	Ar.SerializeIntPacked(DeltaMs);
+
+	LastTimeMs = TimeMs;
+	++RecordCount;
+}
+
+void FTerminalRecorder::RecordTrackball(float AxisX, float AxisY)
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::Trackball);
+	Ar << AxisX << AxisY;
+}
+
+void FTerminalRecorder::RecordDrop(TConstArrayView<int32> TileIndices, int32 BarIndex)
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::Drop);
+
+	uint32 Bar = (uint32)BarIndex;
+	uint32 Count = (uint32)TileIndices.Num();
+	Ar.SerializeIntPacked(Bar);
+	Ar.SerializeIntPacked(Count);
+	for (const int32 TileIndex : TileIndices)
+	{
+		uint32 Packed = (uint32)TileIndex;
+		Ar.SerializeIntPacked(Packed);
+	}
+}
+
+void FTerminalRecorder::RecordApplyChunk(int32 BarIndex)
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::ApplyChunk);
+
+	uint32 Bar = (uint32)BarIndex;
+	Ar.SerializeIntPacked(Bar);
+}
+
+void FTerminalRecorder::RecordStartDay(int32 Seed)
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::StartDay);
+	Ar << Seed;
+}
+
+void FTerminalRecorder::RecordHighlightTimer()
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::HighlightTimer);
+}
+
+void FTerminalRecorder::RecordStressTimer()
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::StressTimer);
+}
+
+void FTerminalRecorder::RecordCooldownTimer(int32 BarIndex)
+{
+	FMemoryWriter Ar(Data, false, true);
+	BeginRecord(Ar, TerminalReplay::ERecord::CooldownTimer);
+
+	uint32 Bar = (uint32)BarIndex;
+	Ar.SerializeIntPacked(Bar);
+}
+
+void FTerminalRecorder::Finish(TArray<uint8>& OutRecording)
+{
+	OutRecording = MoveTemp(Data);
+	Data.Reset();
+	RecordCount = 0;
+	LastTimeMs = 0;
+}
+
+// ========================================
+// REPLAYER
+// ========================================
+
+/**
+ * Validates the header and keeps the start state for Begin.
+ */
+bool FTerminalReplayer::Load(TArray<uint8>&& InRecording)
+{
+	Data = MoveTemp(InRecording);
+	bFinished = true;
+
+	FMemoryReader Ar(Data);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Ar << Magic << Version;
+
+	if (Ar.IsError() || Magic != TerminalReplay::Magic
+		|| Version < (int32)TerminalReplay::EVersion::Initial || Version > (int32)TerminalReplay::EVersion::Latest)
+	{
+		UE_LOG(LogTerminal, Warning, TEXT("Replay: not a valid terminal recording (version %d)"), Version);
+		return false;
+	}
+
+	Ar << Snapshot << RandomSeed << AccumulatorX << AccumulatorY << PendingChunkValue;
+	if (Ar.IsError())
+	{
+		UE_LOG(LogTerminal, Warning, TEXT("Replay: recording header is truncated"));
+		return false;
+	}
+
+	Offset = Ar.Tell();
+	return true;
+}
+
+/**
+ * Restores the snapshot, then the values it doesn't carry.
+ * The terminal must already be in replay mode so ReadSnapshot doesn't arm timers.
+ */
+bool FTerminalReplayer::Begin(ATerminalActor& Terminal)
+{
+	if (Snapshot.Num() == 0 || !Terminal.ReadSnapshot(Snapshot))
+	{
+		return false;
+	}
+
+	Terminal.GridRandomStream.Initialize(RandomSeed);
+	Terminal.AccumulatorX = AccumulatorX;
+	Terminal.AccumulatorY = AccumulatorY;
+	Terminal.PendingChunkValue = PendingChunkValue;
+
+	bHasPending = false;
+	PendingTimeMs = 0;
+	AppliedCount = 0;
+	bFinished = false;
+	return true;
+}
+
+/**
+ * Applies records in order until the next one lies after PlaybackSeconds.
+ */
+int32 FTerminalReplayer::Advance(ATerminalActor& Terminal, double PlaybackSeconds)
+{
+	if (bFinished)
+	{
+		return 0;
+	}
+
+	FMemoryReader Ar(Data);
+	Ar.Seek(Offset);
+
+	const uint32 LimitMs = (uint32)FMath::Clamp(PlaybackSeconds * 1000.0, 0.0, (double)MAX_uint32);
+
+	int32 Applied = 0;
+	while (true)
+	{
+		if (!bHasPending && !ReadNextHeader(Ar))
+		{
+			bFinished = true;
+			break;
+		}
+		if (PendingTimeMs > LimitMs)
+		{
+			break;
+		}
+
+		bHasPending = false;
+		if (!ApplyPending(Ar, Terminal))
+		{
+			UE_LOG(LogTerminal, Warning, TEXT("Replay: corrupt record after %d records, stopping"), AppliedCount);
+			bFinished = true;
+			break;
+		}
+		++Applied;
+		++AppliedCount;
+	}
+
+	Offset = Ar.Tell();
+	return Applied;
+}
+
+/**
+ * Reads a record's tag and delta time.
+ */
+bool FTerminalReplayer::ReadNextHeader(FArchive& Ar)
+{
+	if (Ar.Tell() >= Ar.TotalSize())
+	{
+		return false;
+	}
+
+	uint8 Tag = 0;
+	uint32 DeltaMs = 0;
+	Ar << Tag;
+	Ar.SerializeIntPacked(DeltaMs);
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	PendingType = (TerminalReplay::ERecord)Tag;
+	PendingTimeMs += DeltaMs;
+	bHasPending = true;
+	return true;
+}
+
+/**
+ * Decodes one payload and replays it through the same call the session made.
+ */
+bool FTerminalReplayer::ApplyPending(FArchive& Ar, ATerminalActor& Terminal)
+{
+	using TerminalReplay::ERecord;
+
+	switch (PendingType)
+	{
+	case ERecord::Trackball:
+	{
+		float AxisX = 0.f;
+		float AxisY = 0.f;
+		Ar << AxisX << AxisY;
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		Terminal.ApplyTrackballInput(AxisX, AxisY);
+		return true;
+	}
+
+	case ERecord::Drop:
+	{
+		uint32 Bar = 0;
+		uint32 Count = 0;
+		Ar.SerializeIntPacked(Bar);
+		Ar.SerializeIntPacked(Count);
+
+		// Every index takes at least one byte
+		if (Ar.IsError() || Count > (uint32)(Ar.TotalSize() - Ar.Tell()))
+		{
+			return false;
+		}
+
+		DropIndices.SetNumUninitialized((int32)Count, EAllowShrinking::No);
+		for (int32& TileIndex : DropIndices)
+		{
+			uint32 Packed = 0;
+			Ar.SerializeIntPacked(Packed);
+			TileIndex = (int32)Packed;
+		}
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		Terminal.HandleScaryDropSpan(DropIndices, (int32)Bar);
+		return true;
+	}
+
+	case ERecord::ApplyChunk:
+	{
+		uint32 Bar = 0;
+		Ar.SerializeIntPacked(Bar);
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		Terminal.ApplChunkToBar((int32)Bar);
+		return true;
+	}
+
+	case ERecord::StartDay:
+	{
+		int32 Seed = 0;
+		Ar << Seed;
+		if (Ar.IsError())
+		{
+			return false;
+		}
+
+		// Use the recorded seed; a prebuilt grid only counts if it is for that seed
+		if (!(Terminal.IsNextDayReady() && Terminal.NextDaySeed == Seed))
+		{
+			Terminal.NextDayGrid.Reset();
+		}
+		TGuardValue<bool> FixedSeed(Terminal.bRandomizeDaySeed, false);
+		Terminal.DaySeed = Seed;
+		Terminal.StartDay();
+		return true;
+	}
+
+	case ERecord::HighlightTimer:
+		Terminal.HandleHighlightTimer();
+		return true;
+
+	case ERecord::StressTimer:
+		Terminal.HandleStressTimer();
+		return true;
+
+	case ERecord::CooldownTimer:
+	{
+		uint32 Bar = 0;
+		Ar.SerializeIntPacked(Bar);
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		Terminal.EndBarCooldown((int32)Bar);
+		return true;
+	}
+	}
+
+	return false;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ATerminalActor;
+class UWorld;
+
+namespace TerminalReplay
+{
+	/** 'TRPL' - identifies a terminal recording */
+	static constexpr uint32 Magic = 0x5452504C;
+
+	/** Recording format versions. Add new entries above LatestPlusOne. */
+	enum class EVersion : int32
+	{
+		Initial = 1,
+
+		LatestPlusOne,
+		Latest = LatestPlusOne - 1
+	};
+
+	/** Record tags. Never renumber - recordings store them. */
+	enum class ERecord : uint8
+	{
+		/** ApplyTrackballInput(X, Y) */
+		Trackball = 0,
+
+		/** HandleScaryDrop(Indices, Bar) */
+		Drop = 1,
+
+		/** ApplChunkToBar(Bar) */
+		ApplyChunk = 2,
+
+		/** StartDay; stores the seed the day actually used */
+		StartDay = 3,
+
+		/** The highlight timer fired */
+		HighlightTimer = 4,
+
+		/** The stress timer fired */
+		StressTimer = 5,
+
+		/** A bar cooldown timer fired */
+		CooldownTimer = 6
+	};
+}
+
+/**
+ * Captures a terminal session as a compact binary stream.
+ *
+ * The stream starts with the terminal's snapshot (see ATerminalActor::WriteSnapshot)
+ * plus the few values the snapshot leaves out (RNG state, sub-tile scroll and the
+ * pending chunk). After that every player call and every timer the terminal
+ * reacted to is appended as a tag, a packed millisecond delta since the previous
+ * record and a small payload, so a trackball frame costs about 10 bytes.
+ *
+ * Timers are recorded because their firing times depend on the frame rate; the
+ * replay feeds them back at the recorded points instead of running them.
+ */
+class PROJECT_REFINEMENT_API FTerminalRecorder
+{
+public:
+	/** Starts a recording from the terminal's current state */
+	explicit FTerminalRecorder(const ATerminalActor& Terminal);
+
+	void RecordTrackball(float AxisX, float AxisY);
+	void RecordDrop(TConstArrayView<int32> TileIndices, int32 BarIndex);
+	void RecordApplyChunk(int32 BarIndex);
+	void RecordStartDay(int32 Seed);
+	void RecordHighlightTimer();
+	void RecordStressTimer();
+	void RecordCooldownTimer(int32 BarIndex);
+
+	/** Records written so far */
+	int32 GetRecordCount() const { return RecordCount; }
+
+	/** Hands over the recording; the recorder is empty afterwards */
+	void Finish(TArray<uint8>& OutRecording);
+
+private:
+	/** Writes a record's tag and its delta time */
+	void BeginRecord(FArchive& Ar, TerminalReplay::ERecord Type);
+
+	TArray<uint8> Data;
+	TWeakObjectPtr<const UWorld> World;
+
+	/** World time the recording started */
+	double StartTime = 0.0;
+
+	/** Milliseconds since StartTime of the previous record */
+	uint32 LastTimeMs = 0;
+
+	int32 RecordCount = 0;
+};
+
+/**
+ * Plays a recording back into a terminal.
+ *
+ * Begin restores the recorded starting state; Advance then applies the records
+ * up to a playback time, calling the same entry points the player and the timers
+ * called. While a replay owns a terminal its own difficulty and cooldown timers
+ * are not armed, so the result is the same at any playback speed.
+ */
+class PROJECT_REFINEMENT_API FTerminalReplayer
+{
+public:
+	/**
+	 * Reads the header of a recording.
+	 *
+	 * @return false if the bytes are not a recording this build understands
+	 */
+	bool Load(TArray<uint8>&& InRecording);
+
+	/** Restores the recorded starting state into a terminal */
+	bool Begin(ATerminalActor& Terminal);
+
+	/**
+	 * Applies every record up to a playback time (seconds since Begin).
+	 *
+	 * @return Records applied
+	 */
+	int32 Advance(ATerminalActor& Terminal, double PlaybackSeconds);
+
+	/** All records applied, or the stream was corrupt */
+	bool IsFinished() const { return bFinished; }
+
+	/** Records applied since Begin */
+	int32 GetAppliedCount() const { return AppliedCount; }
+
+private:
+	/** Reads the next record's tag and time into PendingType / PendingTimeMs */
+	bool ReadNextHeader(FArchive& Ar);
+
+	/** Reads the pending record's payload and calls into the terminal */
+	bool ApplyPending(FArchive& Ar, ATerminalActor& Terminal);
+
+	TArray<uint8> Data;
+
+	/** Header values */
+	TArray<uint8> Snapshot;
+	int32 RandomSeed = 0;
+	float AccumulatorX = 0.f;
+	float AccumulatorY = 0.f;
+	float PendingChunkValue = 0.f;
+
+	/** Read position of the next unread byte */
+	int64 Offset = 0;
+
+	/** A record header has been read but its payload not yet applied */
+	bool bHasPending = false;
+	TerminalReplay::ERecord PendingType = TerminalReplay::ERecord::Trackball;
+	uint32 PendingTimeMs = 0;
+
+	bool bFinished = true;
+	int32 AppliedCount = 0;
+
+	/** Reused for drop records */
+	TArray<int32> DropIndices;
+};
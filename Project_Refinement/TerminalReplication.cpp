@@ -0,0 +1,146 @@
+#include "TerminalReplication.h"
+#include "TerminalActor.h"
+
+// ========================================
+// TILE DELTAS
+// ========================================
+
+/**
+ * Client: a tile was eaten or changed scary state for the first time.
+ */
+void FTerminalTileDelta::PostReplicatedAdd(const FTerminalTileDeltaArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->ApplyReplicatedTile(*this);
+	}
+}
+
+/**
+ * Client: a tile that was already changed changed again.
+ */
+void FTerminalTileDelta::PostReplicatedChange(const FTerminalTileDeltaArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->ApplyReplicatedTile(*this);
+	}
+}
+
+/**
+ * Adds or updates a tile entry, marking only that item dirty.
+ */
+void FTerminalTileDeltaArray::SetTile(int32 Index, uint8 Number, bool bScary)
+{
+	if (const int32* ItemIndex = ItemIndexByTile.Find(Index))
+	{
+		FTerminalTileDelta& Item = Items[*ItemIndex];
+		if (Item.Number != Number || Item.bScary != bScary)
+		{
+			Item.Number = Number;
+			Item.bScary = bScary;
+			MarkItemDirty(Item);
+		}
+		return;
+	}
+
+	FTerminalTileDelta& Item = Items.AddDefaulted_GetRef();
+	Item.Index = Index;
+	Item.Number = Number;
+	Item.bScary = bScary;
+	ItemIndexByTile.Add(Index, Items.Num() - 1);
+	MarkItemDirty(Item);
+}
+
+/**
+ * Drops every entry.
+ */
+void FTerminalTileDeltaArray::Clear()
+{
+	if (Items.Num() == 0)
+	{
+		return;
+	}
+
+	Items.Reset();
+	ItemIndexByTile.Reset();
+	MarkArrayDirty();
+}
+
+/**
+ * Client: all adds/changes of this packet have been applied - refresh the view once.
+ */
+void FTerminalTileDeltaArray::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (Owner)
+	{
+		Owner->FlushReplicatedTiles();
+	}
+}
+
+// ========================================
+// VIEW & BARS
+// ========================================
+
+/**
+ * Scroll as packed ints (small values are one byte), sub-tile scroll as one signed byte per axis.
+ */
+bool FTerminalReplicatedView::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedX = (uint32)ScrollX;
+	uint32 PackedY = (uint32)ScrollY;
+	Ar.SerializeIntPacked(PackedX);
+	Ar.SerializeIntPacked(PackedY);
+	Ar << SubTileX << SubTileY;
+
+	if (Ar.IsLoading())
+	{
+		ScrollX = (int32)PackedX;
+		ScrollY = (int32)PackedY;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+/**
+ * Fills always; cooldown times only for bars flagged in the cooling mask.
+ */
+bool FTerminalReplicatedBars::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	for (int32 BarIndex = 0; BarIndex < NumBars; ++BarIndex)
+	{
+		Ar << Fill[BarIndex];
+	}
+
+	uint8 CoolingMask = 0;
+	if (Ar.IsSaving())
+	{
+		for (int32 BarIndex = 0; BarIndex < NumBars; ++BarIndex)
+		{
+			CoolingMask |= CooldownRemaining[BarIndex] > 0 ? (1 << BarIndex) : 0;
+		}
+	}
+	Ar << CoolingMask;
+
+	for (int32 BarIndex = 0; BarIndex < NumBars; ++BarIndex)
+	{
+		uint32 Remaining = CooldownRemaining[BarIndex];
+		if (CoolingMask & (1 << BarIndex))
+		{
+			Ar.SerializeIntPacked(Remaining);
+		}
+		else
+		{
+			Remaining = 0;
+		}
+
+		if (Ar.IsLoading())
+		{
+			CooldownRemaining[BarIndex] = (uint16)FMath::Min<uint32>(Remaining, MAX_uint16);
+		}
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
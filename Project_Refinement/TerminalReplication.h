@@ -0,0 +1,180 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "TerminalGridStore.h"
+#include "TerminalReplication.generated.h"
+
+class ATerminalActor;
+struct FTerminalTileDeltaArray;
+
+/**
+ * Settings a client needs to rebuild a terminal's grid locally.
+ * The map itself is never sent: every client generates it from the seed.
+ */
+USTRUCT()
+struct FTerminalReplicatedGrid
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Seed = 0;
+
+	UPROPERTY()
+	int32 Width = 0;
+
+	UPROPERTY()
+	int32 Height = 0;
+
+	UPROPERTY()
+	ETerminalGridMode Mode = ETerminalGridMode::Eager;
+};
+
+/**
+ * Current state of one tile that differs from the seeded grid (eaten or scary changed).
+ */
+USTRUCT()
+struct FTerminalTileDelta : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Global tile index */
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	/** Current number (1-9) */
+	UPROPERTY()
+	uint8 Number = 0;
+
+	/** Current scary state */
+	UPROPERTY()
+	bool bScary = false;
+
+	void PostReplicatedAdd(const FTerminalTileDeltaArray& InArraySerializer);
+	void PostReplicatedChange(const FTerminalTileDeltaArray& InArraySerializer);
+};
+
+/**
+ * Fast-array list of changed tiles.
+ *
+ * Only tiles that differ from the seeded grid are listed, and only items that
+ * changed since a client's last update are sent, so bandwidth scales with the
+ * number of tiles eaten instead of the map size. Late joiners receive the full
+ * list once and apply it on top of the grid they generated from the seed.
+ */
+USTRUCT()
+struct FTerminalTileDeltaArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FTerminalTileDelta> Items;
+
+	/** Terminal that owns the list (receives client callbacks) */
+	ATerminalActor* Owner = nullptr;
+
+	/** Server: adds or updates the entry for a tile */
+	void SetTile(int32 Index, uint8 Number, bool bScary);
+
+	/** Server: removes every entry (new grid) */
+	void Clear();
+
+	/** Client: applies everything received in one packet together */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FTerminalTileDelta, FTerminalTileDeltaArray>(Items, DeltaParms, *this);
+	}
+
+private:
+	/** Server: position of each tile's entry in Items */
+	TMap<int32, int32> ItemIndexByTile;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTerminalTileDeltaArray> : public TStructOpsTypeTraitsBase2<FTerminalTileDeltaArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * Viewport position, quantized for the wire:
+ * tile scroll as packed ints plus the sub-tile accumulator in 1/127 steps.
+ */
+USTRUCT()
+struct FTerminalReplicatedView
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 ScrollX = 0;
+
+	UPROPERTY()
+	int32 ScrollY = 0;
+
+	/** Sub-tile scroll (-127..127 = -1..1 tile) */
+	UPROPERTY()
+	int8 SubTileX = 0;
+
+	UPROPERTY()
+	int8 SubTileY = 0;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FTerminalReplicatedView& Other) const
+	{
+		return ScrollX == Other.ScrollX && ScrollY == Other.ScrollY && SubTileX == Other.SubTileX && SubTileY == Other.SubTileY;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FTerminalReplicatedView> : public TStructOpsTypeTraitsBase2<FTerminalReplicatedView>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+/**
+ * Progress bars and cooldowns in a few bytes:
+ * fills as 16-bit fractions, cooldowns as a bitmask plus remaining centiseconds.
+ */
+USTRUCT()
+struct FTerminalReplicatedBars
+{
+	GENERATED_BODY()
+
+	static constexpr int32 NumBars = 4;
+
+	/** Bar fill, 0..65535 = 0..1 */
+	UPROPERTY()
+	uint16 Fill[NumBars] = { 0, 0, 0, 0 };
+
+	/** Cooldown left when it was published, in centiseconds (0 = not cooling) */
+	UPROPERTY()
+	uint16 CooldownRemaining[NumBars] = { 0, 0, 0, 0 };
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FTerminalReplicatedBars& Other) const
+	{
+		return FMemory::Memcmp(Fill, Other.Fill, sizeof(Fill)) == 0
+			&& FMemory::Memcmp(CooldownRemaining, Other.CooldownRemaining, sizeof(CooldownRemaining)) == 0;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FTerminalReplicatedBars> : public TStructOpsTypeTraitsBase2<FTerminalReplicatedBars>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
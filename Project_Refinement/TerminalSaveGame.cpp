@@ -0,0 +1 @@
+#include "TerminalSaveGame.h"
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "TerminalSaveGame.generated.h"
+
+/**
+ * Save game wrapper for one terminal's snapshot.
+ *
+ * The terminal's state is not stored as individual properties: the grid alone
+ * would be megabytes through the default property path. Instead the terminal
+ * writes a compact versioned binary snapshot (see ATerminalActor::WriteSnapshot),
+ * which is usually a few KB, and this object only carries those bytes to disk.
+ */
+UCLASS()
+class PROJECT_REFINEMENT_API UTerminalSaveGame : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	/** Binary snapshot produced by ATerminalActor::WriteSnapshot */
+	UPROPERTY()
+	TArray<uint8> Snapshot;
+};
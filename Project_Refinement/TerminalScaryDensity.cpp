@@ -0,0 +1,273 @@
+#include "TerminalScaryDensity.h"
+
+#include <atomic>
+
+namespace
+{
+	/** Source of table revisions; shared by all tables so a new grid never reuses an old revision */
+	std::atomic<uint32> GNextDensityRevision{ 0 };
+}
+
+/**
+ * Sets up a zeroed table.
+ * The last sector row/column may be partial if the map is not a multiple of the sector size.
+ */
+void FTerminalScaryDensity::Init(int32 InMapWidth, int32 InMapHeight, int32 InSectorSize)
+{
+	MapWidth = FMath::Max(InMapWidth, 1);
+	MapHeight = FMath::Max(InMapHeight, 1);
+	SectorSize = FMath::Max(InSectorSize, 1);
+	SectorsX = FMath::DivideAndRoundUp(MapWidth, SectorSize);
+	SectorsY = FMath::DivideAndRoundUp(MapHeight, SectorSize);
+
+	Table.Reset();
+	Table.SetNumZeroed((SectorsX + 1) * (SectorsY + 1));
+	BumpRevision();
+}
+
+/**
+ * Frees the table.
+ */
+void FTerminalScaryDensity::Reset()
+{
+	MapWidth = 0;
+	MapHeight = 0;
+	SectorsX = 0;
+	SectorsY = 0;
+	Table.Empty();
+	BumpRevision();
+}
+
+/**
+ * With the same count everywhere, entry (X, Y) is simply Count * X * Y.
+ */
+void FTerminalScaryDensity::Fill(int32 CountPerSector)
+{
+	const int32 Stride = SectorsX + 1;
+	for (int32 Y = 0; Y <= SectorsY; ++Y)
+	{
+		for (int32 X = 0; X <= SectorsX; ++X)
+		{
+			Table[Y * Stride + X] = CountPerSector * X * Y;
+		}
+	}
+	BumpRevision();
+}
+
+/**
+ * Patches the table below and to the right of the tile's sector.
+ * Each row of the patch is a contiguous run, so the compiler vectorizes it.
+ */
+void FTerminalScaryDensity::ApplyDelta(int32 X, int32 Y, int32 Delta)
+{
+	if (Table.Num() == 0 || X < 0 || Y < 0 || X >= MapWidth || Y >= MapHeight)
+	{
+		return;
+	}
+
+	const int32 Stride = SectorsX + 1;
+	const int32 FirstColumn = X / SectorSize + 1;
+	const int32 RunLength = Stride - FirstColumn;
+
+	for (int32 Row = Y / SectorSize + 1; Row <= SectorsY; ++Row)
+	{
+		int32* Entry = Table.GetData() + Row * Stride + FirstColumn;
+		for (int32 i = 0; i < RunLength; ++i)
+		{
+			Entry[i] += Delta;
+		}
+	}
+	BumpRevision();
+}
+
+/**
+ * Takes the next global revision.
+ */
+void FTerminalScaryDensity::BumpRevision()
+{
+	Revision = GNextDensityRevision.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+/**
+ * Single-sector count from the table's four corners.
+ */
+int32 FTerminalScaryDensity::GetSectorCount(int32 SectorX, int32 SectorY) const
+{
+	if (Table.Num() == 0 || SectorX < 0 || SectorY < 0 || SectorX >= SectorsX || SectorY >= SectorsY)
+	{
+		return 0;
+	}
+
+	return CountBlock(SectorX, SectorY, SectorX + 1, SectorY + 1);
+}
+
+// ========================================
+// QUERIES
+// ========================================
+
+/**
+ * Splits each axis at the map seam and sums the resulting blocks.
+ */
+int32 FTerminalScaryDensity::CountSectors(int32 SectorX, int32 SectorY, int32 NumX, int32 NumY) const
+{
+	if (Table.Num() == 0)
+	{
+		return 0;
+	}
+
+	FSectorSpan Columns[2];
+	FSectorSpan Rows[2];
+	const int32 NumColumns = GetWrappedSpans(SectorX, NumX, SectorsX, Columns);
+	const int32 NumRows = GetWrappedSpans(SectorY, NumY, SectorsY, Rows);
+
+	return CountSpans(Columns, NumColumns, Rows, NumRows);
+}
+
+/**
+ * Maps the tile rectangle onto the sectors it touches, then counts those.
+ */
+int32 FTerminalScaryDensity::CountInRect(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight) const
+{
+	if (Table.Num() == 0 || RectWidth <= 0 || RectHeight <= 0)
+	{
+		return 0;
+	}
+
+	FSectorSpan Columns[2];
+	FSectorSpan Rows[2];
+	const int32 NumColumns = GetSectorSpans(StartX, StartX + RectWidth - 1, MapWidth, SectorSize, SectorsX, Columns);
+	const int32 NumRows = GetSectorSpans(StartY, StartY + RectHeight - 1, MapHeight, SectorSize, SectorsY, Rows);
+
+	return CountSpans(Columns, NumColumns, Rows, NumRows);
+}
+
+/**
+ * Same window as FTerminalScaryIndex::FindNearest, so the count covers every tile the sensor could see.
+ */
+int32 FTerminalScaryDensity::CountInRadius(float CenterX, float CenterY, float Radius) const
+{
+	if (Table.Num() == 0 || Radius < 0.f)
+	{
+		return 0;
+	}
+
+	const int32 MinX = FMath::FloorToInt(CenterX - Radius);
+	const int32 MinY = FMath::FloorToInt(CenterY - Radius);
+	const int32 MaxX = FMath::CeilToInt(CenterX + Radius);
+	const int32 MaxY = FMath::CeilToInt(CenterY + Radius);
+
+	return CountInRect(MinX, MinY, MaxX - MinX + 1, MaxY - MinY + 1);
+}
+
+/**
+ * Sums the up to four blocks a wrapped rectangle splits into.
+ */
+int32 FTerminalScaryDensity::CountSpans(const FSectorSpan (&Columns)[2], int32 NumColumns, const FSectorSpan (&Rows)[2], int32 NumRows) const
+{
+	int32 Count = 0;
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		for (int32 Column = 0; Column < NumColumns; ++Column)
+		{
+			Count += CountBlock(Columns[Column].Min, Rows[Row].Min, Columns[Column].Max, Rows[Row].Max);
+		}
+	}
+	return Count;
+}
+
+/**
+ * A range shorter than the axis wraps at most once, giving a span up to the seam and one after it.
+ * If both spans reach the same sector (a partial edge sector) the whole axis is used instead.
+ */
+int32 FTerminalScaryDensity::GetSectorSpans(int32 RangeMin, int32 RangeMax, int32 MapSize, int32 InSectorSize, int32 SectorCount, FSectorSpan (&OutSpans)[2])
+{
+	if (RangeMax < RangeMin)
+	{
+		return 0;
+	}
+
+	// Window covers the whole axis - every sector is touched
+	if (RangeMax - RangeMin + 1 >= MapSize)
+	{
+		OutSpans[0] = { 0, SectorCount };
+		return 1;
+	}
+
+	int32 WrappedMin = RangeMin % MapSize;
+	if (WrappedMin < 0) WrappedMin += MapSize;
+	const int32 WrappedMax = WrappedMin + (RangeMax - RangeMin);
+
+	if (WrappedMax < MapSize)
+	{
+		OutSpans[0] = { WrappedMin / InSectorSize, WrappedMax / InSectorSize + 1 };
+		return 1;
+	}
+
+	OutSpans[0] = { WrappedMin / InSectorSize, SectorCount };
+	OutSpans[1] = { 0, (WrappedMax - MapSize) / InSectorSize + 1 };
+	if (OutSpans[1].Max > OutSpans[0].Min)
+	{
+		OutSpans[0] = { 0, SectorCount };
+		return 1;
+	}
+	return 2;
+}
+
+/**
+ * Sector ranges wrap the same way, without the partial sector case.
+ */
+int32 FTerminalScaryDensity::GetWrappedSpans(int32 First, int32 Num, int32 SectorCount, FSectorSpan (&OutSpans)[2])
+{
+	if (Num <= 0 || SectorCount <= 0)
+	{
+		return 0;
+	}
+
+	if (Num >= SectorCount)
+	{
+		OutSpans[0] = { 0, SectorCount };
+		return 1;
+	}
+
+	int32 WrappedFirst = First % SectorCount;
+	if (WrappedFirst < 0) WrappedFirst += SectorCount;
+
+	const int32 End = WrappedFirst + Num;
+	if (End <= SectorCount)
+	{
+		OutSpans[0] = { WrappedFirst, End };
+		return 1;
+	}
+
+	OutSpans[0] = { WrappedFirst, SectorCount };
+	OutSpans[1] = { 0, End - SectorCount };
+	return 2;
+}
+
+// ========================================
+// EXPORT
+// ========================================
+
+/**
+ * One texel per sector, scaled so FullCount tiles saturate.
+ */
+void FTerminalScaryDensity::WriteTexels(TArray<uint8>& OutTexels, int32 FullCount) const
+{
+	OutTexels.SetNumUninitialized(SectorsX * SectorsY);
+	if (OutTexels.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 Scale = FMath::Max(FullCount, 1);
+	uint8* Texel = OutTexels.GetData();
+
+	for (int32 SectorY = 0; SectorY < SectorsY; ++SectorY)
+	{
+		for (int32 SectorX = 0; SectorX < SectorsX; ++SectorX)
+		{
+			const int32 Count = CountBlock(SectorX, SectorY, SectorX + 1, SectorY + 1);
+			*Texel++ = (uint8)FMath::Min(Count * 255 / Scale, 255);
+		}
+	}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Per-sector scary counts with a summed-area table, for density queries over the whole torus.
+ *
+ * The map is split into square sectors (the grid store's sector size) and the table
+ * holds, for every sector corner, the number of scary tiles above and to the left of it.
+ * Any sector rectangle is then counted with four lookups, and a rectangle that wraps
+ * around the map edges is split into at most four such rectangles.
+ *
+ * Flips patch the table in place: a tile changing state only changes the entries
+ * below and to the right of its sector, which is a few hundred additions on the
+ * default map. Reads never write, so a store's density can be read from any thread.
+ *
+ * Queries work at sector resolution: a tile rectangle counts every sector it
+ * touches, so answers include tiles up to one sector outside it.
+ * The table is (SectorsX + 1) x (SectorsY + 1) int32s, ~160 KB for a 10k x 10k map.
+ */
+class PROJECT_REFINEMENT_API FTerminalScaryDensity
+{
+public:
+	/** Sets up an empty table for a MapWidth x MapHeight map */
+	void Init(int32 InMapWidth, int32 InMapHeight, int32 InSectorSize);
+
+	/** Frees the table */
+	void Reset();
+
+	/** Sets every sector to the same count and rebuilds the table (e.g. one seeded tile per sector) */
+	void Fill(int32 CountPerSector);
+
+	/** Counts a tile gained at wrapped map coordinates */
+	void Add(int32 X, int32 Y) { ApplyDelta(X, Y, 1); }
+
+	/** Counts a tile lost at wrapped map coordinates */
+	void Remove(int32 X, int32 Y) { ApplyDelta(X, Y, -1); }
+
+	/** Number of sectors along X */
+	int32 GetSectorsX() const { return SectorsX; }
+
+	/** Number of sectors along Y */
+	int32 GetSectorsY() const { return SectorsY; }
+
+	/** Size of one sector edge in tiles */
+	int32 GetSectorSize() const { return SectorSize; }
+
+	/**
+	 * Changes every time a count changes, unique across all tables,
+	 * so a consumer can tell whether its copy (e.g. a minimap texture) is stale.
+	 */
+	uint32 GetRevision() const { return Revision; }
+
+	/** Scary tiles in one sector (0 if out of range) */
+	int32 GetSectorCount(int32 SectorX, int32 SectorY) const;
+
+	/** Scary tiles on the whole map */
+	int32 GetTotalCount() const { return Table.Num() > 0 ? Table.Last() : 0; }
+
+	/**
+	 * Counts the scary tiles in a rectangle of sectors, wrapping at the map edges.
+	 *
+	 * @param SectorX - First sector column (any value, wraps automatically)
+	 * @param SectorY - First sector row (any value, wraps automatically)
+	 * @param NumX - Sector columns to count (clamped to the map)
+	 * @param NumY - Sector rows to count (clamped to the map)
+	 */
+	int32 CountSectors(int32 SectorX, int32 SectorY, int32 NumX, int32 NumY) const;
+
+	/**
+	 * Counts the scary tiles in every sector touched by a tile rectangle.
+	 *
+	 * @param StartX - Left edge in tiles (any value, wraps automatically)
+	 * @param StartY - Top edge in tiles (any value, wraps automatically)
+	 * @param RectWidth - Width in tiles
+	 * @param RectHeight - Height in tiles
+	 */
+	int32 CountInRect(int32 StartX, int32 StartY, int32 RectWidth, int32 RectHeight) const;
+
+	/**
+	 * Counts the scary tiles in every sector touched by the square of Radius tiles
+	 * around a point (Chebyshev distance, the same window the sensor searches).
+	 */
+	int32 CountInRadius(float CenterX, float CenterY, float Radius) const;
+
+	/**
+	 * Writes one byte per sector, row-major (SectorsX x SectorsY), for a minimap texture.
+	 * A sector holding FullCount or more tiles writes 255, an empty one 0.
+	 */
+	void WriteTexels(TArray<uint8>& OutTexels, int32 FullCount) const;
+
+	/** Heap memory used by the table, in bytes */
+	SIZE_T GetAllocatedSize() const { return Table.GetAllocatedSize(); }
+
+private:
+	/** Half-open range of sector rows or columns */
+	struct FSectorSpan
+	{
+		int32 Min = 0;
+		int32 Max = 0;
+	};
+
+	/**
+	 * Converts the raw tile range [RangeMin, RangeMax] on an axis of MapSize tiles into
+	 * one or two non-wrapping sector spans.
+	 *
+	 * @return Number of spans written (0 for an empty range)
+	 */
+	static int32 GetSectorSpans(int32 RangeMin, int32 RangeMax, int32 MapSize, int32 InSectorSize, int32 SectorCount, FSectorSpan (&OutSpans)[2]);
+
+	/** Same as GetSectorSpans, for a raw sector range */
+	static int32 GetWrappedSpans(int32 First, int32 Num, int32 SectorCount, FSectorSpan (&OutSpans)[2]);
+
+	/** Sums every combination of column and row spans */
+	int32 CountSpans(const FSectorSpan (&Columns)[2], int32 NumColumns, const FSectorSpan (&Rows)[2], int32 NumRows) const;
+
+	/** Scary tiles in the sectors [MinX, MaxX) x [MinY, MaxY), no wrapping */
+	int32 CountBlock(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const
+	{
+		const int32 Stride = SectorsX + 1;
+		return Table[MaxY * Stride + MaxX] - Table[MinY * Stride + MaxX] - Table[MaxY * Stride + MinX] + Table[MinY * Stride + MinX];
+	}
+
+	/** Adds Delta to the sector holding a tile and to every table entry it contributes to */
+	void ApplyDelta(int32 X, int32 Y, int32 Delta);
+
+	/** Takes a fresh revision */
+	void BumpRevision();
+
+	/**
+	 * Summed-area table, (SectorsX + 1) x (SectorsY + 1), row-major.
+	 * Entry (X, Y) is the count of sectors [0, X) x [0, Y); row 0 and column 0 stay zero.
+	 */
+	TArray<int32> Table;
+
+	int32 MapWidth = 0;
+	int32 MapHeight = 0;
+	int32 SectorSize = 1;
+	int32 SectorsX = 0;
+	int32 SectorsY = 0;
+	uint32 Revision = 0;
+};
@@ -0,0 +1,147 @@
+#include "TerminalScaryIndex.h"
+#include "TerminalWrap.h"
+
+/**
+ * Sets up one empty bucket per sector.
+ * The last sector row/column may be partial if the map is not a multiple of the sector size.
+ */
+void FTerminalScaryIndex::Init(int32 InMapWidth, int32 InMapHeight, int32 InSectorSize)
+{
+	MapWidth = FMath::Max(InMapWidth, 1);
+	MapHeight = FMath::Max(InMapHeight, 1);
+	SectorSize = FMath::Max(InSectorSize, 1);
+	SectorsX = FMath::DivideAndRoundUp(MapWidth, SectorSize);
+	SectorsY = FMath::DivideAndRoundUp(MapHeight, SectorSize);
+
+	Buckets.Reset();
+	Buckets.SetNum(SectorsX * SectorsY);
+}
+
+/**
+ * Frees all buckets.
+ */
+void FTerminalScaryIndex::Reset()
+{
+	MapWidth = 0;
+	MapHeight = 0;
+	SectorsX = 0;
+	SectorsY = 0;
+	Buckets.Empty();
+}
+
+/**
+ * Adds a scary tile to its sector bucket.
+ */
+void FTerminalScaryIndex::Add(int32 X, int32 Y)
+{
+	const int32 BucketIdx = GetBucketIndex(X, Y);
+	if (Buckets.IsValidIndex(BucketIdx))
+	{
+		Buckets[BucketIdx].Add(FIntPoint(X, Y));
+	}
+}
+
+/**
+ * Removes a scary tile from its sector bucket.
+ */
+void FTerminalScaryIndex::Remove(int32 X, int32 Y)
+{
+	const int32 BucketIdx = GetBucketIndex(X, Y);
+	if (Buckets.IsValidIndex(BucketIdx))
+	{
+		Buckets[BucketIdx].RemoveSingleSwap(FIntPoint(X, Y));
+	}
+}
+
+/**
+ * Collects the distinct sectors along one axis touched by a raw (unwrapped) tile range.
+ * Walks the range one sector at a time in wrapped space, so partial edge sectors
+ * and ranges that cross the map seam are both handled.
+ */
+void FTerminalScaryIndex::GatherSectorSpan(int32 RangeMin, int32 RangeMax, int32 MapSize, int32 InSectorSize, int32 SectorCount, TArray<int32, TInlineAllocator<8>>& OutSectors)
+{
+	OutSectors.Reset();
+
+	// Window covers the whole axis - every sector is touched
+	if (RangeMax - RangeMin + 1 >= MapSize)
+	{
+		for (int32 Sector = 0; Sector < SectorCount; ++Sector)
+		{
+			OutSectors.Add(Sector);
+		}
+		return;
+	}
+
+	DispatchTerminalWrapAxis(MapSize, [&](const auto& Wrap)
+	{
+		int32 Raw = RangeMin;
+		while (Raw <= RangeMax)
+		{
+			const int32 Wrapped = Wrap(Raw);
+
+			const int32 Sector = Wrapped / InSectorSize;
+			OutSectors.AddUnique(Sector);
+
+			// Jump to the first tile of the next sector (or the map seam)
+			const int32 SectorEnd = FMath::Min((Sector + 1) * InSectorSize, MapSize);
+			Raw += SectorEnd - Wrapped;
+		}
+	});
+}
+
+/**
+ * Finds the closest scary tile by visiting only the sectors overlapping the
+ * square search window around the query point.
+ */
+bool FTerminalScaryIndex::FindNearest(float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared) const
+{
+	if (Buckets.Num() == 0 || MaxDistance <= 0.f)
+	{
+		return false;
+	}
+
+	// Wrap the query point onto the map so tile coordinates can be compared directly
+	const float WrappedCenterX = CenterX - MapWidth * FMath::FloorToFloat(CenterX / MapWidth);
+	const float WrappedCenterY = CenterY - MapHeight * FMath::FloorToFloat(CenterY / MapHeight);
+
+	TArray<int32, TInlineAllocator<8>> Columns;
+	TArray<int32, TInlineAllocator<8>> Rows;
+	GatherSectorSpan(FMath::FloorToInt(CenterX - MaxDistance), FMath::CeilToInt(CenterX + MaxDistance), MapWidth, SectorSize, SectorsX, Columns);
+	GatherSectorSpan(FMath::FloorToInt(CenterY - MaxDistance), FMath::CeilToInt(CenterY + MaxDistance), MapHeight, SectorSize, SectorsY, Rows);
+
+	float MinDistSq = FMath::Square(MaxDistance);
+	bool bFound = false;
+
+	for (const int32 SectorY : Rows)
+	{
+		for (const int32 SectorX : Columns)
+		{
+			for (const FIntPoint& Tile : Buckets[SectorY * SectorsX + SectorX])
+			{
+				// Shortest delta on the torus
+				const float DistSq = GetTorusDistanceSquared(Tile.X, Tile.Y, WrappedCenterX, WrappedCenterY, MapWidth, MapHeight);
+				if (DistSq < MinDistSq)
+				{
+					MinDistSq = DistSq;
+					bFound = true;
+				}
+			}
+		}
+	}
+
+	OutDistanceSquared = MinDistSq;
+	return bFound;
+}
+
+/**
+ * Reports heap memory owned by the index.
+ */
+SIZE_T FTerminalScaryIndex::GetAllocatedSize() const
+{
+	SIZE_T Size = Buckets.GetAllocatedSize();
+	for (const FSectorBucket& Bucket : Buckets)
+	{
+		Size += Bucket.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Sector-bucketed spatial index of scary tiles.
+ *
+ * The map is split into square sectors and every scary tile is stored in the
+ * bucket of the sector it falls in. Scary tiles are sparse (roughly one per
+ * 50x50 sector), so a radius query only has to look at the handful of
+ * sectors overlapping the search window instead of scanning every cell.
+ *
+ * Distances are measured on the torus: the map wraps at every edge, so a tile
+ * near the right edge is close to a point near the left edge.
+ */
+class PROJECT_REFINEMENT_API FTerminalScaryIndex
+{
+public:
+	/** Sets up empty buckets for a MapWidth x MapHeight map */
+	void Init(int32 InMapWidth, int32 InMapHeight, int32 InSectorSize);
+
+	/** Frees all buckets */
+	void Reset();
+
+	/** Adds a scary tile at wrapped map coordinates. The caller guarantees it is not already present. */
+	void Add(int32 X, int32 Y);
+
+	/** Removes a scary tile at wrapped map coordinates, if present */
+	void Remove(int32 X, int32 Y);
+
+	/**
+	 * Finds the scary tile closest to a point.
+	 *
+	 * @param CenterX - X of the query point in tiles (any value, wraps automatically)
+	 * @param CenterY - Y of the query point in tiles (any value, wraps automatically)
+	 * @param MaxDistance - Search radius in tiles; tiles at or beyond it are ignored
+	 * @param OutDistanceSquared - Squared distance to the closest tile when found
+	 * @return true if a scary tile lies within MaxDistance
+	 */
+	bool FindNearest(float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared) const;
+
+	/** Size of one sector edge in tiles */
+	int32 GetSectorSize() const { return SectorSize; }
+
+	/** Number of sectors along X */
+	int32 GetSectorsX() const { return SectorsX; }
+
+	/** Number of sectors along Y */
+	int32 GetSectorsY() const { return SectorsY; }
+
+	/** Calls Func(X, Y) for every indexed scary tile, in bucket order */
+	template<typename FuncType>
+	void ForEachTile(FuncType&& Func) const
+	{
+		for (const FSectorBucket& Bucket : Buckets)
+		{
+			for (const FIntPoint& Tile : Bucket)
+			{
+				Func(Tile.X, Tile.Y);
+			}
+		}
+	}
+
+	/** Heap memory used by the index, in bytes */
+	SIZE_T GetAllocatedSize() const;
+
+	/**
+	 * Collects the sector rows or columns touched by the raw tile range [RangeMin, RangeMax]
+	 * on an axis of MapSize tiles, handling wrap-around and partial last sectors.
+	 */
+	static void GatherSectorSpan(int32 RangeMin, int32 RangeMax, int32 MapSize, int32 InSectorSize, int32 SectorCount, TArray<int32, TInlineAllocator<8>>& OutSectors);
+
+	/** Squared shortest distance on the torus between a tile and an already wrapped point */
+	static float GetTorusDistanceSquared(int32 TileX, int32 TileY, float WrappedCenterX, float WrappedCenterY, int32 InMapWidth, int32 InMapHeight)
+	{
+		float DeltaX = TileX - WrappedCenterX;
+		if (DeltaX > InMapWidth * 0.5f) DeltaX -= InMapWidth;
+		else if (DeltaX < -InMapWidth * 0.5f) DeltaX += InMapWidth;
+
+		float DeltaY = TileY - WrappedCenterY;
+		if (DeltaY > InMapHeight * 0.5f) DeltaY -= InMapHeight;
+		else if (DeltaY < -InMapHeight * 0.5f) DeltaY += InMapHeight;
+
+		return DeltaX * DeltaX + DeltaY * DeltaY;
+	}
+
+private:
+	/** Scary tiles of one sector; most sectors hold 0-2 tiles */
+	typedef TArray<FIntPoint, TInlineAllocator<4>> FSectorBucket;
+
+	/** Bucket index for wrapped map coordinates */
+	int32 GetBucketIndex(int32 X, int32 Y) const
+	{
+		return (Y / SectorSize) * SectorsX + (X / SectorSize);
+	}
+
+	int32 MapWidth = 0;
+	int32 MapHeight = 0;
+	int32 SectorSize = 1;
+	int32 SectorsX = 0;
+	int32 SectorsY = 0;
+
+	/** SectorsX * SectorsY buckets, row-major */
+	TArray<FSectorBucket> Buckets;
+};
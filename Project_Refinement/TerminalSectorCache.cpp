@@ -0,0 +1,114 @@
+#include "TerminalSectorCache.h"
+
+/**
+ * Starts empty with the default budget.
+ */
+FTerminalSectorCache::FTerminalSectorCache()
+	: Sectors(ComputeCapacity())
+{
+}
+
+/**
+ * Takes over the budget of another cache but none of its sectors.
+ */
+FTerminalSectorCache::FTerminalSectorCache(const FTerminalSectorCache& Other)
+	: BudgetBytes(Other.BudgetBytes)
+	, SectorSize(Other.SectorSize)
+	, Sectors(ComputeCapacity())
+{
+}
+
+/**
+ * Takes over the budget of another cache and drops this cache's sectors.
+ */
+FTerminalSectorCache& FTerminalSectorCache::operator=(const FTerminalSectorCache& Other)
+{
+	if (this != &Other)
+	{
+		Configure(Other.BudgetBytes, Other.SectorSize);
+	}
+	return *this;
+}
+
+/**
+ * Applies a new budget; the capacity follows from the size of one sector.
+ */
+void FTerminalSectorCache::Configure(SIZE_T InBudgetBytes, int32 InSectorSize)
+{
+	BudgetBytes = InBudgetBytes;
+	SectorSize = FMath::Max(InSectorSize, 1);
+	Sectors.Empty(ComputeCapacity());
+}
+
+/**
+ * Looks a sector up without touching the recency order.
+ * Used by point queries so random probes across the map don't evict the viewport.
+ */
+FTerminalSector* FTerminalSectorCache::Find(int32 SectorIndex) const
+{
+	const TSharedPtr<FTerminalSector>* Sector = Sectors.Find(SectorIndex);
+	return Sector ? Sector->Get() : nullptr;
+}
+
+/**
+ * Looks a sector up and marks it as most recently used.
+ */
+FTerminalSector* FTerminalSectorCache::FindAndTouch(int32 SectorIndex)
+{
+	const TSharedPtr<FTerminalSector>* Sector = Sectors.FindAndTouch(SectorIndex);
+	return Sector ? Sector->Get() : nullptr;
+}
+
+/**
+ * Adds a fresh sector; the LRU cache evicts its oldest entry when full.
+ */
+FTerminalSector& FTerminalSectorCache::Add(int32 SectorIndex)
+{
+	checkSlow(!Sectors.Contains(SectorIndex));
+
+	TSharedPtr<FTerminalSector> Sector = MakeShared<FTerminalSector>();
+	Sector->Numbers.SetNumUninitialized(SectorSize * SectorSize);
+	Sectors.Add(SectorIndex, Sector);
+	return *Sector;
+}
+
+/**
+ * Drops one sector.
+ */
+void FTerminalSectorCache::Remove(int32 SectorIndex)
+{
+	Sectors.Remove(SectorIndex);
+}
+
+/**
+ * Drops every sector.
+ */
+void FTerminalSectorCache::Empty()
+{
+	Sectors.Empty(ComputeCapacity());
+}
+
+/**
+ * Number bytes plus the sector struct and its shared pointer control block.
+ */
+SIZE_T FTerminalSectorCache::GetBytesPerSector(int32 InSectorSize)
+{
+	return sizeof(FTerminalSector) + 2 * sizeof(void*) + (SIZE_T)InSectorSize * InSectorSize;
+}
+
+/**
+ * Sectors that fit in the budget, never less than one.
+ */
+int32 FTerminalSectorCache::ComputeCapacity() const
+{
+	const SIZE_T Capacity = BudgetBytes / GetBytesPerSector(SectorSize);
+	return (int32)FMath::Clamp<SIZE_T>(Capacity, 1, MAX_int32);
+}
+
+/**
+ * Reports heap memory of the resident sectors.
+ */
+SIZE_T FTerminalSectorCache::GetAllocatedSize() const
+{
+	return (SIZE_T)Sectors.Num() * GetBytesPerSector(SectorSize);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+
+/**
+ * One materialized map sector of a Streamed grid.
+ * Holds the current numbers of the sector (seeded values with eaten tiles applied)
+ * and the coordinates of the scary tiles inside it.
+ */
+struct FTerminalSector
+{
+	/** Numbers 1-9, row-major SectorSize x SectorSize (cells past a partial edge sector are unused) */
+	TArray<uint8> Numbers;
+
+	/** Global coordinates of the sector's scary tiles; usually just the seeded one */
+	TArray<FIntPoint, TInlineAllocator<2>> ScaryTiles;
+};
+
+/**
+ * Bounded least-recently-used cache of materialized sectors.
+ *
+ * A Streamed grid has no per-cell storage: any sector can be rebuilt from the
+ * seed and the store's change maps. The cache keeps the sectors around the
+ * viewport and sensor resident so bulk reads are plain copies, and evicts the
+ * least recently used sector once the memory budget is reached.
+ *
+ * Cached sectors are derived data, so copying a cache gives an empty cache with
+ * the same budget. This keeps grid stores cheap to copy and share.
+ */
+class PROJECT_REFINEMENT_API FTerminalSectorCache
+{
+public:
+	/** Default budget for a grid store that never had one applied */
+	static constexpr SIZE_T DefaultBudgetBytes = 1024 * 1024;
+
+	FTerminalSectorCache();
+
+	/** Copies the budget only; cached sectors are not shared between stores */
+	FTerminalSectorCache(const FTerminalSectorCache& Other);
+	FTerminalSectorCache& operator=(const FTerminalSectorCache& Other);
+
+	/**
+	 * Sets the memory budget and sector size, dropping every cached sector.
+	 * The cache always holds at least one sector, whatever the budget.
+	 */
+	void Configure(SIZE_T InBudgetBytes, int32 InSectorSize);
+
+	/** Cached sector without changing its recency, or null if it is not resident */
+	FTerminalSector* Find(int32 SectorIndex) const;
+
+	/** Cached sector marked as most recently used, or null if it is not resident */
+	FTerminalSector* FindAndTouch(int32 SectorIndex);
+
+	/**
+	 * Adds an empty sector (evicting the least recently used one when full).
+	 * The caller fills it; the sector must not already be resident.
+	 */
+	FTerminalSector& Add(int32 SectorIndex);
+
+	/** Drops a single sector, if resident */
+	void Remove(int32 SectorIndex);
+
+	/** Drops every cached sector and keeps the budget */
+	void Empty();
+
+	/** Number of resident sectors */
+	int32 Num() const { return Sectors.Num(); }
+
+	/** Maximum number of resident sectors for the current budget */
+	int32 GetCapacity() const { return Sectors.Max(); }
+
+	/** Memory budget in bytes */
+	SIZE_T GetBudget() const { return BudgetBytes; }
+
+	/** Approximate heap memory of one materialized sector */
+	static SIZE_T GetBytesPerSector(int32 InSectorSize);
+
+	/** Heap memory used by the resident sectors, in bytes */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Sectors that fit in the budget (at least one) */
+	int32 ComputeCapacity() const;
+
+	/** Memory budget in bytes */
+	SIZE_T BudgetBytes = DefaultBudgetBytes;
+
+	/** Edge length of a sector in tiles (set by the grid store in Configure) */
+	int32 SectorSize = 50;
+
+	/** Resident sectors keyed by sector index (Y * SectorsX + X); declared last so it is built from the budget */
+	TLruCache<int32, TSharedPtr<FTerminalSector>> Sectors;
+};
@@ -0,0 +1,262 @@
+#include "TerminalSensorKernel.h"
+#include "TerminalWrap.h"
+
+namespace
+{
+	/** Delta for "no tile in this direction"; its square still fits a float */
+	constexpr float NoTileDelta = 1.0e15f;
+
+	/** Shortest distance on a ring of Size tiles for a raw delta of at most one ring */
+	FORCEINLINE float GetRingDelta(float Delta, int32 Size)
+	{
+		const float AbsDelta = FMath::Abs(Delta);
+		return FMath::Min(AbsDelta, Size - AbsDelta);
+	}
+}
+
+/**
+ * Picks the wrap policy once for the query; every row and span wrap inside inlines to it.
+ */
+bool FTerminalSensorKernel::FindNearest(const TBitArray<>& ScaryMask, int32 MapWidth, int32 MapHeight,
+	float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared)
+{
+	if (MapWidth <= 0 || MapHeight <= 0 || ScaryMask.Num() != MapWidth * MapHeight || MaxDistance <= 0.f)
+	{
+		return false;
+	}
+
+	return DispatchTerminalWrap(MapWidth, MapHeight, [&](const auto& WrapX, const auto& WrapY)
+	{
+		return FindNearestWrapped(ScaryMask, MapWidth, MapHeight, WrapX, WrapY, CenterX, CenterY, MaxDistance, OutDistanceSquared);
+	});
+}
+
+/**
+ * Walks rows outward from the center, narrowing the scanned columns to the best
+ * distance so far, and stops as soon as the row distance alone is too far.
+ */
+template<typename WrapType>
+bool FTerminalSensorKernel::FindNearestWrapped(const TBitArray<>& ScaryMask, int32 MapWidth, int32 MapHeight,
+	const WrapType& WrapX, const WrapType& WrapY, float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared)
+{
+	const uint32* Words = ScaryMask.GetData();
+
+	// Wrap the query point onto the map so tile coordinates can be compared directly
+	const float WrappedCenterX = CenterX - MapWidth * FMath::FloorToFloat(CenterX / MapWidth);
+	const float WrappedCenterY = CenterY - MapHeight * FMath::FloorToFloat(CenterY / MapHeight);
+	const int32 CenterColumn = FMath::Clamp(FMath::FloorToInt(WrappedCenterX), 0, MapWidth - 1);
+	const int32 CenterRow = FMath::Clamp(FMath::FloorToInt(WrappedCenterY), 0, MapHeight - 1);
+
+	// ========================================
+	// Step 1: Search Window
+	// ========================================
+	// Raw columns either side of the center. A window as wide as the map
+	// searches one full ring in each direction instead.
+	const int32 WindowMinX = FMath::FloorToInt(WrappedCenterX - MaxDistance);
+	const int32 WindowMaxX = FMath::CeilToInt(WrappedCenterX + MaxDistance);
+	const bool bWholeRow = WindowMaxX - WindowMinX + 1 >= MapWidth;
+	const int32 LeftLimit = bWholeRow ? CenterColumn - MapWidth + 1 : WindowMinX;
+	const int32 RightLimit = bWholeRow ? CenterColumn + MapWidth - 1 : WindowMaxX;
+
+	// Row offsets from CenterRow; a window as tall as the map visits every row exactly once
+	const int32 WindowMinY = FMath::FloorToInt(WrappedCenterY - MaxDistance);
+	const int32 WindowMaxY = FMath::CeilToInt(WrappedCenterY + MaxDistance);
+	const bool bWholeColumn = WindowMaxY - WindowMinY + 1 >= MapHeight;
+	const int32 MinOffset = bWholeColumn ? -(MapHeight / 2) : WindowMinY - CenterRow;
+	const int32 MaxOffset = bWholeColumn ? MinOffset + MapHeight - 1 : WindowMaxY - CenterRow;
+	const int32 MaxAbsOffset = FMath::Max(-MinOffset, MaxOffset);
+
+	// ========================================
+	// Step 2: Rows Outward From the Center
+	// ========================================
+	float MinDistSq = FMath::Square(MaxDistance);
+
+	// Offsets in the order 0, +1, -1, +2, -2, ...
+	for (int32 Step = 0; Step <= 2 * MaxAbsOffset; ++Step)
+	{
+		const int32 Offset = (Step & 1) ? (Step + 1) / 2 : -(Step / 2);
+
+		// Every later row is at least |Offset| - 1 away vertically
+		if (FMath::Square((float)FMath::Max(FMath::Abs(Offset) - 1, 0)) >= MinDistSq)
+		{
+			break;
+		}
+
+		if (Offset < MinOffset || Offset > MaxOffset)
+		{
+			continue;
+		}
+
+		const int32 RawRow = CenterRow + Offset;
+		const float Dy = GetRingDelta(RawRow - WrappedCenterY, MapHeight);
+		const float ReachSq = MinDistSq - Dy * Dy;
+		if (ReachSq <= 0.f)
+		{
+			continue;
+		}
+
+		// Only columns that could still beat the best distance are scanned
+		const float Reach = FMath::Sqrt(ReachSq);
+		const int32 RowStart = WrapY(RawRow) * MapWidth;
+
+		float Left = NoTileDelta;
+		float Right = NoTileDelta;
+		int32 RawX = 0;
+
+		if (FindNearestLeft(Words, RowStart, MapWidth, WrapX, FMath::Max(LeftLimit, FMath::FloorToInt(WrappedCenterX - Reach)), CenterColumn, RawX))
+		{
+			Left = GetRingDelta(WrappedCenterX - RawX, MapWidth);
+		}
+		if (FindNearestRight(Words, RowStart, MapWidth, WrapX, CenterColumn + 1, FMath::Min(RightLimit, FMath::CeilToInt(WrappedCenterX + Reach)), RawX))
+		{
+			Right = GetRingDelta(RawX - WrappedCenterX, MapWidth);
+		}
+
+		if (Left == NoTileDelta && Right == NoTileDelta)
+		{
+			continue;
+		}
+
+		// Updated per row, so the next row's reach already uses it
+		const float Dx = FMath::Min(Left, Right);
+		MinDistSq = FMath::Min(MinDistSq, Dy * Dy + Dx * Dx);
+	}
+
+	// Tiles exactly at MaxDistance don't count, same as the sector index
+	OutDistanceSquared = MinDistSq;
+	return MinDistSq < FMath::Square(MaxDistance);
+}
+
+// ========================================
+// BIT SCANS
+// ========================================
+
+/**
+ * Scans words from the end of the range, masking the partial words at both ends.
+ */
+int32 FTerminalSensorKernel::FindLastSetBit(const uint32* Words, int32 Begin, int32 End)
+{
+	if (Begin >= End)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 FirstWord = Begin >> 5;
+	int32 WordIndex = (End - 1) >> 5;
+	uint32 Word = Words[WordIndex] & (MAX_uint32 >> (31 - ((End - 1) & 31)));
+
+	for (;;)
+	{
+		if (WordIndex == FirstWord)
+		{
+			Word &= MAX_uint32 << (Begin & 31);
+			return Word ? (WordIndex << 5) + (int32)FMath::FloorLog2(Word) : INDEX_NONE;
+		}
+
+		if (Word)
+		{
+			return (WordIndex << 5) + (int32)FMath::FloorLog2(Word);
+		}
+
+		Word = Words[--WordIndex];
+	}
+}
+
+/**
+ * Scans words from the start of the range, masking the partial words at both ends.
+ */
+int32 FTerminalSensorKernel::FindFirstSetBit(const uint32* Words, int32 Begin, int32 End)
+{
+	if (Begin >= End)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 LastWord = (End - 1) >> 5;
+	int32 WordIndex = Begin >> 5;
+	uint32 Word = Words[WordIndex] & (MAX_uint32 << (Begin & 31));
+
+	for (;;)
+	{
+		if (WordIndex == LastWord)
+		{
+			Word &= MAX_uint32 >> (31 - ((End - 1) & 31));
+			return Word ? (WordIndex << 5) + (int32)FMath::CountTrailingZeros(Word) : INDEX_NONE;
+		}
+
+		if (Word)
+		{
+			return (WordIndex << 5) + (int32)FMath::CountTrailingZeros(Word);
+		}
+
+		Word = Words[++WordIndex];
+	}
+}
+
+/**
+ * Searches the span ending at RawTo first, then the part that wrapped past the row start.
+ */
+template<typename WrapType>
+bool FTerminalSensorKernel::FindNearestLeft(const uint32* Words, int32 RowStart, int32 MapWidth, const WrapType& WrapX, int32 RawFrom, int32 RawTo, int32& OutRawX)
+{
+	const int32 Length = RawTo - RawFrom + 1;
+	if (Length <= 0)
+	{
+		return false;
+	}
+
+	const int32 WrappedTo = WrapX(RawTo);
+
+	// Span 1: from RawTo back towards column 0
+	const int32 FirstLength = FMath::Min(Length, WrappedTo + 1);
+	int32 Bit = FindLastSetBit(Words, RowStart + WrappedTo + 1 - FirstLength, RowStart + WrappedTo + 1);
+	if (Bit != INDEX_NONE)
+	{
+		OutRawX = RawTo - (RowStart + WrappedTo - Bit);
+		return true;
+	}
+
+	// Span 2: the rest continues from the last column of the row
+	const int32 Rest = Length - FirstLength;
+	Bit = FindLastSetBit(Words, RowStart + MapWidth - Rest, RowStart + MapWidth);
+	if (Bit != INDEX_NONE)
+	{
+		OutRawX = RawTo - FirstLength - (RowStart + MapWidth - 1 - Bit);
+		return true;
+	}
+	return false;
+}
+
+/**
+ * Searches the span starting at RawFrom first, then the part that wrapped past the row end.
+ */
+template<typename WrapType>
+bool FTerminalSensorKernel::FindNearestRight(const uint32* Words, int32 RowStart, int32 MapWidth, const WrapType& WrapX, int32 RawFrom, int32 RawTo, int32& OutRawX)
+{
+	const int32 Length = RawTo - RawFrom + 1;
+	if (Length <= 0)
+	{
+		return false;
+	}
+
+	const int32 WrappedFrom = WrapX(RawFrom);
+
+	// Span 1: from RawFrom towards the last column
+	const int32 FirstLength = FMath::Min(Length, MapWidth - WrappedFrom);
+	int32 Bit = FindFirstSetBit(Words, RowStart + WrappedFrom, RowStart + WrappedFrom + FirstLength);
+	if (Bit != INDEX_NONE)
+	{
+		OutRawX = RawFrom + (Bit - RowStart - WrappedFrom);
+		return true;
+	}
+
+	// Span 2: the rest continues from column 0
+	const int32 Rest = Length - FirstLength;
+	Bit = FindFirstSetBit(Words, RowStart, RowStart + Rest);
+	if (Bit != INDEX_NONE)
+	{
+		OutRawX = RawFrom + FirstLength + (Bit - RowStart);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Nearest-scary bit-scan kernel over a grid's packed scary bitset.
+ *
+ * The sector index (FTerminalScaryIndex) is fastest while scary tiles are sparse,
+ * but late in a day highlights can make hundreds of tiles scary and every sector
+ * bucket it visits fills up. This kernel's cost doesn't depend on the scary count:
+ *
+ * - Rows are visited outward from the center, and the search stops once no
+ *   remaining row can beat the best distance so far
+ * - In each row, the nearest set bit left and right of the center is found with
+ *   32-bit word scans (one count-leading/trailing-zeros per word), splitting the
+ *   row into two spans at the map seam
+ * - Each row only scans the columns that could still beat the best distance so far
+ *
+ * FTerminalGridStore::FindNearestScary picks between the two per query, from the
+ * number of tiles the sector index would have to visit (see ShouldUseDense).
+ */
+class PROJECT_REFINEMENT_API FTerminalSensorKernel
+{
+public:
+	/** Sparse candidates that cost about as much as scanning one row of the bitset */
+	static constexpr int32 CandidatesPerRow = 4;
+
+	/**
+	 * Whether the dense scan should beat the sector index for a query.
+	 *
+	 * @param SparseCandidates - Scary tiles in the sectors the index would visit
+	 * @param MaxDistance - Search radius in tiles
+	 * @param MapHeight - Map height in tiles (rows past it are not scanned twice)
+	 */
+	static bool ShouldUseDense(int32 SparseCandidates, float MaxDistance, int32 MapHeight)
+	{
+		const int32 Rows = FMath::Min(2 * FMath::CeilToInt(MaxDistance) + 1, MapHeight);
+		return SparseCandidates > Rows * CandidatesPerRow;
+	}
+
+	/**
+	 * Finds the scary tile closest to a point, on the torus.
+	 * Same contract as FTerminalScaryIndex::FindNearest.
+	 *
+	 * @param ScaryMask - One bit per cell, row-major, MapWidth x MapHeight
+	 * @param CenterX - X of the query point in tiles (any value, wraps automatically)
+	 * @param CenterY - Y of the query point in tiles (any value, wraps automatically)
+	 * @param MaxDistance - Search radius in tiles; tiles at or beyond it are ignored
+	 * @param OutDistanceSquared - Squared distance to the closest tile when found
+	 * @return true if a scary tile lies within MaxDistance
+	 */
+	static bool FindNearest(const TBitArray<>& ScaryMask, int32 MapWidth, int32 MapHeight,
+		float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared);
+
+private:
+	/** FindNearest with the wrap policy fixed (FTerminalWrapMasked or FTerminalWrapModulo) */
+	template<typename WrapType>
+	static bool FindNearestWrapped(const TBitArray<>& ScaryMask, int32 MapWidth, int32 MapHeight,
+		const WrapType& WrapX, const WrapType& WrapY, float CenterX, float CenterY, float MaxDistance, float& OutDistanceSquared);
+
+	/** Highest set bit in the global bit range [Begin, End), or INDEX_NONE */
+	static int32 FindLastSetBit(const uint32* Words, int32 Begin, int32 End);
+
+	/** Lowest set bit in the global bit range [Begin, End), or INDEX_NONE */
+	static int32 FindFirstSetBit(const uint32* Words, int32 Begin, int32 End);
+
+	/**
+	 * Finds the last scary tile in the raw (unwrapped) columns [RawFrom, RawTo] of a row.
+	 * The range may cross the seam but must be at most one map width long.
+	 *
+	 * @param RowStart - Global index of column 0 of the row
+	 * @param OutRawX - Raw column of the tile, on the same unwrapped axis as the range
+	 */
+	template<typename WrapType>
+	static bool FindNearestLeft(const uint32* Words, int32 RowStart, int32 MapWidth, const WrapType& WrapX, int32 RawFrom, int32 RawTo, int32& OutRawX);
+
+	/** Same as FindNearestLeft, for the first scary tile of the range */
+	template<typename WrapType>
+	static bool FindNearestRight(const uint32* Words, int32 RowStart, int32 MapWidth, const WrapType& WrapX, int32 RawFrom, int32 RawTo, int32& OutRawX);
+};
@@ -0,0 +1,294 @@
+#include "TerminalSnakeSearch.h"
+#include "Algo/Sort.h"
+
+namespace TerminalSnakeSearch
+{
+	/** Per-cell hash key (SplitMix64 finalizer); XOR of the keys identifies a set of cells */
+	static FORCEINLINE uint64 GetCellKey(int32 Cell)
+	{
+		uint64 Z = (uint64)Cell * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull;
+		Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		return Z ^ (Z >> 31);
+	}
+
+	/** Mixes the head into a set hash, so the same set ending elsewhere hashes differently */
+	static FORCEINLINE uint64 GetStateHash(uint64 SetHash, int32 Head)
+	{
+		const uint64 Key = GetCellKey(Head);
+		return SetHash ^ ((Key << 29) | (Key >> 35));
+	}
+}
+
+/**
+ * Scores the window, builds the neighbour masks and seeds layer 0 with every tile.
+ */
+bool FTerminalSnakeSearch::Begin(int32 InWidth, int32 InHeight, TConstArrayView<int32> Numbers, TConstArrayView<bool> Scary, const FTerminalSnakeSearchSettings& InSettings)
+{
+	bRunning = false;
+	ResultCount = 0;
+
+	if (InWidth <= 0 || InHeight <= 0 || InWidth * InHeight > MaxCells
+		|| Numbers.Num() != InWidth * InHeight || Scary.Num() != InWidth * InHeight)
+	{
+		return false;
+	}
+
+	Width = InWidth;
+	Height = InHeight;
+	NumCells = Width * Height;
+
+	Settings = InSettings;
+	Settings.MaxLength = FMath::Clamp(Settings.MaxLength, 1, FMath::Min(32, NumCells));
+	Settings.MinLength = FMath::Clamp(Settings.MinLength, 1, Settings.MaxLength);
+	Settings.BeamWidth = FMath::Clamp(Settings.BeamWidth, 1, 1024);
+	Settings.NumResults = FMath::Clamp(Settings.NumResults, 1, (int32)UE_ARRAY_COUNT(Results));
+
+	// ========================================
+	// Step 1: Cell Scores & Adjacency
+	// ========================================
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		bCellScary[Cell] = Numbers[Cell] > 0 && Scary[Cell];
+		CellScore[Cell] = Numbers[Cell] > 0 ? Numbers[Cell] * (bCellScary[Cell] ? 4 : 1) : 0;
+	}
+
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		FTerminalBitboard& Mask = NeighborMask[Cell];
+		Mask = FTerminalBitboard();
+
+		const int32 X = Cell % Width;
+		const int32 Y = Cell / Width;
+		if (X > 0 && Numbers[Cell - 1] > 0) Mask.Set(Cell - 1);
+		if (X < Width - 1 && Numbers[Cell + 1] > 0) Mask.Set(Cell + 1);
+		if (Y > 0 && Numbers[Cell - Width] > 0) Mask.Set(Cell - Width);
+		if (Y < Height - 1 && Numbers[Cell + Width] > 0) Mask.Set(Cell + Width);
+	}
+
+	// ========================================
+	// Step 2: Size the Buffers
+	// ========================================
+	// Layer 0 holds every tile; later layers hold BeamWidth snakes.
+	// Grown only, so repeated searches reuse the memory.
+	LayerCapacity = FMath::Max(NumCells, Settings.BeamWidth);
+	States.SetNum(Settings.MaxLength * LayerCapacity, EAllowShrinking::No);
+	LayerCounts.SetNumZeroed(Settings.MaxLength, EAllowShrinking::No);
+	Candidates.Reset();
+	Candidates.Reserve(LayerCapacity * 4);
+
+	// ========================================
+	// Step 3: Seed Layer 0
+	// ========================================
+	int32 Count = 0;
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		if (Numbers[Cell] <= 0)
+		{
+			continue;
+		}
+
+		FState& State = GetState(0, Count++);
+		State.Visited = FTerminalBitboard();
+		State.Visited.Set(Cell);
+		State.SetHash = TerminalSnakeSearch::GetCellKey(Cell);
+		State.Score = CellScore[Cell];
+		State.Parent = INDEX_NONE;
+		State.Head = (uint8)Cell;
+		State.ScaryCount = bCellScary[Cell] ? 1 : 0;
+	}
+
+	Algo::Sort(TArrayView<FState>(&GetState(0, 0), Count), [](const FState& A, const FState& B)
+	{
+		return A.Score > B.Score;
+	});
+	LayerCounts[0] = Count;
+
+	if (Settings.MinLength <= 1)
+	{
+		CollectResults(0);
+	}
+
+	CurrentLayer = 0;
+	NextState = 0;
+	bRunning = Count > 0 && Settings.MaxLength > 1;
+	return Count > 0;
+}
+
+/**
+ * Expands the current layer state by state, checking the clock every few states.
+ */
+bool FTerminalSnakeSearch::Step(double BudgetSeconds)
+{
+	if (!bRunning)
+	{
+		return true;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const uint64 BudgetCycles = BudgetSeconds > 0.0 ? (uint64)(BudgetSeconds / FPlatformTime::GetSecondsPerCycle64()) : MAX_uint64;
+	constexpr int32 StatesPerClockCheck = 32;
+	int32 StatesSinceCheck = 0;
+
+	while (bRunning)
+	{
+		const int32 Count = LayerCounts[CurrentLayer];
+		while (NextState < Count)
+		{
+			const FState& State = GetState(CurrentLayer, NextState);
+			const int16 Parent = (int16)NextState;
+
+			// Every free neighbour of the head is one extension
+			NeighborMask[State.Head].AndNot(State.Visited).ForEachSetBit([this, &State, Parent](int32 Cell)
+			{
+				FCandidate& Candidate = Candidates.AddUninitialized_GetRef();
+				Candidate.SetHash = State.SetHash ^ TerminalSnakeSearch::GetCellKey(Cell);
+				Candidate.StateHash = TerminalSnakeSearch::GetStateHash(Candidate.SetHash, Cell);
+				Candidate.Score = State.Score + CellScore[Cell];
+				Candidate.Parent = Parent;
+				Candidate.Cell = (uint8)Cell;
+				Candidate.ScaryCount = State.ScaryCount + (bCellScary[Cell] ? 1 : 0);
+			});
+			++NextState;
+
+			if (++StatesSinceCheck >= StatesPerClockCheck)
+			{
+				StatesSinceCheck = 0;
+				if (FPlatformTime::Cycles64() - StartCycles >= BudgetCycles)
+				{
+					return false;
+				}
+			}
+		}
+
+		FinishLayer();
+	}
+	return true;
+}
+
+/**
+ * Keeps the BeamWidth best extensions as the next layer.
+ * Sorting by (score, state hash) puts interchangeable snakes side by side, so
+ * duplicates are dropped by comparing with the previously kept one.
+ */
+void FTerminalSnakeSearch::FinishLayer()
+{
+	Algo::Sort(Candidates, [](const FCandidate& A, const FCandidate& B)
+	{
+		return A.Score != B.Score ? A.Score > B.Score : A.StateHash < B.StateHash;
+	});
+
+	const int32 NextLayer = CurrentLayer + 1;
+	int32 Kept = 0;
+	const FCandidate* Previous = nullptr;
+
+	for (const FCandidate& Candidate : Candidates)
+	{
+		if (Kept >= Settings.BeamWidth)
+		{
+			break;
+		}
+		if (Previous && Previous->Score == Candidate.Score && Previous->StateHash == Candidate.StateHash)
+		{
+			continue;
+		}
+
+		const FState& ParentState = GetState(CurrentLayer, Candidate.Parent);
+		FState& State = GetState(NextLayer, Kept++);
+		State.Visited = ParentState.Visited;
+		State.Visited.Set(Candidate.Cell);
+		State.SetHash = Candidate.SetHash;
+		State.Score = Candidate.Score;
+		State.Parent = Candidate.Parent;
+		State.Head = Candidate.Cell;
+		State.ScaryCount = Candidate.ScaryCount;
+		Previous = &Candidate;
+	}
+
+	LayerCounts[NextLayer] = Kept;
+	Candidates.Reset();
+
+	if (NextLayer + 1 >= Settings.MinLength)
+	{
+		CollectResults(NextLayer);
+	}
+
+	CurrentLayer = NextLayer;
+	NextState = 0;
+	bRunning = Kept > 0 && NextLayer + 1 < Settings.MaxLength;
+}
+
+/**
+ * Merges a layer (sorted best first) into the result list, skipping tile sets already listed.
+ */
+void FTerminalSnakeSearch::CollectResults(int32 Layer)
+{
+	const int32 Count = LayerCounts[Layer];
+	for (int32 StateIndex = 0; StateIndex < Count; ++StateIndex)
+	{
+		const FState& State = GetState(Layer, StateIndex);
+		if (ResultCount == Settings.NumResults && State.Score <= Results[ResultCount - 1].Score)
+		{
+			// Everything after this one scores less
+			break;
+		}
+
+		bool bDuplicate = false;
+		for (int32 i = 0; i < ResultCount && !bDuplicate; ++i)
+		{
+			bDuplicate = Results[i].SetHash == State.SetHash;
+		}
+		if (bDuplicate)
+		{
+			continue;
+		}
+
+		// Insertion into the short sorted list
+		int32 Insert = FMath::Min(ResultCount, Settings.NumResults - 1);
+		while (Insert > 0 && Results[Insert - 1].Score < State.Score)
+		{
+			if (Insert < Settings.NumResults)
+			{
+				Results[Insert] = Results[Insert - 1];
+			}
+			--Insert;
+		}
+
+		FResult& Result = Results[Insert];
+		Result.SetHash = State.SetHash;
+		Result.Score = State.Score;
+		Result.Layer = Layer;
+		Result.StateIndex = StateIndex;
+		ResultCount = FMath::Min(ResultCount + 1, Settings.NumResults);
+	}
+}
+
+/**
+ * Walks the parent links back to the first tile.
+ */
+void FTerminalSnakeSearch::GetResult(int32 ResultIndex, TArray<int32>& OutCells, int32& OutScore, int32& OutScaryCount) const
+{
+	OutCells.Reset();
+	OutScore = 0;
+	OutScaryCount = 0;
+
+	if (ResultIndex < 0 || ResultIndex >= ResultCount)
+	{
+		return;
+	}
+
+	const FResult& Result = Results[ResultIndex];
+	OutCells.SetNumUninitialized(Result.Layer + 1);
+
+	int32 StateIndex = Result.StateIndex;
+	for (int32 Layer = Result.Layer; Layer >= 0; --Layer)
+	{
+		const FState& State = GetState(Layer, StateIndex);
+		OutCells[Layer] = State.Head;
+		StateIndex = State.Parent;
+	}
+
+	const FState& Last = GetState(Result.Layer, Result.StateIndex);
+	OutScore = Last.Score;
+	OutScaryCount = Last.ScaryCount;
+}
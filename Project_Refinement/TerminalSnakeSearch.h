@@ -0,0 +1,237 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TerminalSnakeSearch.generated.h"
+
+/**
+ * Tuning for a best-snake search.
+ */
+USTRUCT(BlueprintType)
+struct FTerminalSnakeSearchSettings
+{
+	GENERATED_BODY()
+
+	/** Shortest snake reported */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Hints", meta = (ClampMin = "1"))
+	int32 MinLength = 2;
+
+	/** Longest snake searched (also the number of beam layers) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Hints", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 MaxLength = 8;
+
+	/** Partial snakes kept per length; wider finds better snakes, linearly slower */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Hints", meta = (ClampMin = "1", ClampMax = "1024"))
+	int32 BeamWidth = 64;
+
+	/** Distinct snakes returned (no two cover the same set of tiles) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Hints", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 NumResults = 3;
+
+	/**
+	 * Tiles around the visible window that snakes may pass through.
+	 * Snakes using them can't be dropped until the player scrolls (see bFullyVisible).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Terminal|Hints", meta = (ClampMin = "0", ClampMax = "3"))
+	int32 Border = 0;
+};
+
+/**
+ * One snake found by the search, in path order.
+ */
+USTRUCT(BlueprintType)
+struct FTerminalSnake
+{
+	GENERATED_BODY()
+
+	/** Screen-space indices for HandleScaryDrop; INDEX_NONE for tiles in the border */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Hints")
+	TArray<int32> ScreenIndices;
+
+	/** Chunk value HandleScaryDrop would score for it */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Hints")
+	float Value = 0.f;
+
+	/** Scary tiles eaten by it */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Hints")
+	int32 ScaryCount = 0;
+
+	/** Every tile is on screen, so it can be dropped as is */
+	UPROPERTY(BlueprintReadOnly, Category = "Terminal|Hints")
+	bool bFullyVisible = true;
+};
+
+/**
+ * Fixed 256-cell bitset: one bit per tile of a search region of up to 16x16.
+ */
+struct FTerminalBitboard
+{
+	static constexpr int32 NumWords = 4;
+	static constexpr int32 NumBits = NumWords * 64;
+
+	uint64 Words[NumWords] = { 0, 0, 0, 0 };
+
+	void Set(int32 Cell) { Words[Cell >> 6] |= 1ull << (Cell & 63); }
+	bool Test(int32 Cell) const { return (Words[Cell >> 6] >> (Cell & 63)) & 1; }
+
+	/** Bits of this board not in Other */
+	FTerminalBitboard AndNot(const FTerminalBitboard& Other) const
+	{
+		FTerminalBitboard Result;
+		for (int32 i = 0; i < NumWords; ++i)
+		{
+			Result.Words[i] = Words[i] & ~Other.Words[i];
+		}
+		return Result;
+	}
+
+	/** Calls Func(Cell) for every set bit, lowest first */
+	template<typename FuncType>
+	void ForEachSetBit(FuncType&& Func) const
+	{
+		for (int32 i = 0; i < NumWords; ++i)
+		{
+			uint64 Word = Words[i];
+			while (Word)
+			{
+				Func(i * 64 + (int32)FMath::CountTrailingZeros64(Word));
+				Word &= Word - 1;
+			}
+		}
+	}
+};
+
+/**
+ * Beam search for the highest-scoring snakes in a small window of tiles.
+ *
+ * A snake is a path of orthogonally adjacent tiles that never visits a tile
+ * twice. It scores like HandleScaryDrop: number * 0.005 per tile, four times
+ * that for a scary tile. Scores are summed as integers (number, or 4 x number)
+ * so equal tile sets always compare equal.
+ *
+ * Layer L of the beam holds the BeamWidth best snakes of length L + 1. Each
+ * snake has its visited tiles as a bitboard, so its possible extensions are
+ * one AND-NOT of a precomputed neighbour mask. Snakes that cover the same tiles
+ * and end on the same tile are interchangeable; they have equal scores and
+ * hashes, so they sit next to each other after sorting and only one is kept.
+ *
+ * All buffers are sized in Begin and reused by later searches, so a search
+ * does not allocate while it runs. Step can be given a time budget and resumes
+ * where it stopped, so a search can be spread over several frames.
+ */
+class PROJECT_REFINEMENT_API FTerminalSnakeSearch
+{
+public:
+	/** Largest search window (Width * Height) */
+	static constexpr int32 MaxCells = FTerminalBitboard::NumBits;
+
+	/** HandleScaryDrop's value per integer score point */
+	static constexpr float ValuePerPoint = 0.005f;
+
+	/**
+	 * Prepares a search over a Width x Height window.
+	 * Tiles with number 0 are treated as holes.
+	 *
+	 * @param Numbers - Row-major tile numbers of the window
+	 * @param Scary - Row-major scary flags of the window
+	 * @return false if the window is empty, too large or the inputs don't match it
+	 */
+	bool Begin(int32 InWidth, int32 InHeight, TConstArrayView<int32> Numbers, TConstArrayView<bool> Scary, const FTerminalSnakeSearchSettings& InSettings);
+
+	/**
+	 * Runs the search until it finishes or the budget is used up.
+	 *
+	 * @param BudgetSeconds - Time allowed for this call (<= 0 runs to the end)
+	 * @return true when the search is finished
+	 */
+	bool Step(double BudgetSeconds = 0.0);
+
+	bool IsRunning() const { return bRunning; }
+	bool IsFinished() const { return !bRunning && ResultCount > 0; }
+
+	/** Snakes found so far, best first (also valid while the search is still running) */
+	int32 GetResultCount() const { return ResultCount; }
+
+	/**
+	 * Reads one result.
+	 *
+	 * @param OutCells - Window cells (Y * Width + X) in path order
+	 * @param OutScore - Integer score; multiply by ValuePerPoint for the chunk value
+	 * @param OutScaryCount - Scary tiles on the path
+	 */
+	void GetResult(int32 ResultIndex, TArray<int32>& OutCells, int32& OutScore, int32& OutScaryCount) const;
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+private:
+	/** A snake in the beam; the path is recovered through Parent links into the previous layer */
+	struct FState
+	{
+		FTerminalBitboard Visited;
+
+		/** Hash of the visited set (XOR of per-cell keys) */
+		uint64 SetHash = 0;
+
+		int32 Score = 0;
+		int16 Parent = INDEX_NONE;
+		uint8 Head = 0;
+		uint8 ScaryCount = 0;
+	};
+
+	/** A possible extension of a state, made into a state if it survives the cut */
+	struct FCandidate
+	{
+		uint64 SetHash = 0;
+		uint64 StateHash = 0;
+		int32 Score = 0;
+		int16 Parent = INDEX_NONE;
+		uint8 Cell = 0;
+		uint8 ScaryCount = 0;
+	};
+
+	/** A reported snake */
+	struct FResult
+	{
+		uint64 SetHash = 0;
+		int32 Score = 0;
+		int32 Layer = 0;
+		int32 StateIndex = 0;
+	};
+
+	FState& GetState(int32 Layer, int32 StateIndex) { return States[Layer * LayerCapacity + StateIndex]; }
+	const FState& GetState(int32 Layer, int32 StateIndex) const { return States[Layer * LayerCapacity + StateIndex]; }
+
+	/** Sorts the candidates and keeps the best distinct ones as the next layer */
+	void FinishLayer();
+
+	/** Offers the snakes of a finished layer to the result list */
+	void CollectResults(int32 Layer);
+
+	FTerminalSnakeSearchSettings Settings;
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 NumCells = 0;
+
+	/** Integer score of each cell, and whether it is scary */
+	int32 CellScore[MaxCells];
+	bool bCellScary[MaxCells];
+
+	/** Orthogonal neighbours of each cell (holes excluded) */
+	FTerminalBitboard NeighborMask[MaxCells];
+
+	/** Beam layers, LayerCapacity states each */
+	TArray<FState> States;
+	TArray<int32> LayerCounts;
+	int32 LayerCapacity = 0;
+
+	/** Extensions of the layer being expanded */
+	TArray<FCandidate> Candidates;
+
+	FResult Results[32];
+	int32 ResultCount = 0;
+
+	/** Layer being expanded and the next state in it */
+	int32 CurrentLayer = 0;
+	int32 NextState = 0;
+	bool bRunning = false;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Stats for the refinement terminal, shown with `stat Terminal`.
+ * Cycle stats time the hot paths, the counters reset every frame and the
+ * memory stats follow the grids of all registered terminals.
+ */
+DECLARE_STATS_GROUP(TEXT("Terminal"), STATGROUP_Terminal, STATCAT_Advanced);
+
+// Timings
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Grid"), STAT_TerminalGenerateGrid, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Grid Store"), STAT_TerminalBuildGridStore, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Materialize Sector"), STAT_TerminalMaterializeSector, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sensor Query"), STAT_TerminalSensorQuery, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Scroll"), STAT_TerminalScroll, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sync Viewport"), STAT_TerminalSyncViewport, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drop Scoring"), STAT_TerminalDropScoring, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snake Search"), STAT_TerminalSnakeSearch, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Start Day"), STAT_TerminalStartDay, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("End Day"), STAT_TerminalEndDay, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Jobs"), STAT_TerminalRunJobs, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+
+// Per-frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scroll Events"), STAT_TerminalScrollEvents, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("OnGridScrolled Broadcasts"), STAT_TerminalGridScrolledBroadcasts, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sensor Queries"), STAT_TerminalSensorQueries, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dense Sensor Queries"), STAT_TerminalDenseSensorQueries, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Posted"), STAT_TerminalEventsPosted, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events Dispatched"), STAT_TerminalEventsDispatched, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Job Slices"), STAT_TerminalJobSlices, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Job Budget Overruns"), STAT_TerminalJobBudgetOverruns, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+
+// Memory
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Terminals"), STAT_TerminalCount, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Jobs Pending"), STAT_TerminalJobsPending, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Grid Memory (All Terminals)"), STAT_TerminalGridMemory, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Grid Memory (Largest Terminal)"), STAT_TerminalGridMemoryLargest, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Grid Memory (Active Terminal)"), STAT_TerminalGridMemoryActive, STATGROUP_Terminal, PROJECT_REFINEMENT_API);
+
+/**
+ * Times a scope for both `stat Terminal` and Unreal Insights.
+ * The cycle stat compiles out with STATS (e.g. in Shipping); the CPU trace
+ * event stays wherever CPU profiler tracing is enabled.
+ */
+#define TERMINAL_SCOPE_CYCLE_COUNTER(Stat, TraceName) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_STR(TraceName)
@@ -0,0 +1,190 @@
+#include "TerminalSubsystem.h"
+#include "TerminalActor.h"
+#include "Project_Refinement.h"
+#include "TerminalStats.h"
+
+/**
+ * Releases the registry and every cached grid.
+ */
+void UTerminalSubsystem::Deinitialize()
+{
+	Terminals.Empty();
+	ActiveTerminal.Reset();
+	GridCache.Empty();
+
+	Super::Deinitialize();
+}
+
+// ========================================
+// REGISTRY
+// ========================================
+
+/**
+ * Adds a terminal to the registry and sends it to sleep unless the player is using it.
+ */
+void UTerminalSubsystem::RegisterTerminal(ATerminalActor* Terminal)
+{
+	if (!Terminal)
+	{
+		return;
+	}
+
+	Terminals.AddUnique(Terminal);
+
+	if (ActiveTerminal != Terminal)
+	{
+		Terminal->EnterDormant();
+	}
+	UpdateGridStats();
+}
+
+/**
+ * Removes a terminal from the registry.
+ */
+void UTerminalSubsystem::UnregisterTerminal(ATerminalActor* Terminal)
+{
+	Terminals.RemoveSingleSwap(Terminal);
+	if (ActiveTerminal == Terminal)
+	{
+		ActiveTerminal.Reset();
+	}
+
+	// Its grid may have been the last user of a cache entry
+	TrimGridCache();
+	UpdateGridStats();
+}
+
+/**
+ * Swaps the active terminal.
+ * The new one is woken before the old one sleeps, so a shared grid never
+ * drops out of the cache in between.
+ */
+void UTerminalSubsystem::SetActiveTerminal(ATerminalActor* Terminal)
+{
+	ATerminalActor* Previous = ActiveTerminal.Get();
+	if (Previous == Terminal)
+	{
+		return;
+	}
+
+	ActiveTerminal = Terminal;
+
+	if (Terminal)
+	{
+		Terminals.AddUnique(Terminal);
+		Terminal->WakeFromDormant();
+	}
+
+	if (Previous)
+	{
+		Previous->EnterDormant();
+	}
+	UpdateGridStats();
+}
+
+/**
+ * Lists the registered terminals that still exist.
+ */
+TArray<ATerminalActor*> UTerminalSubsystem::GetTerminals() const
+{
+	TArray<ATerminalActor*> Result;
+	Result.Reserve(Terminals.Num());
+	for (const TWeakObjectPtr<ATerminalActor>& Terminal : Terminals)
+	{
+		if (ATerminalActor* Live = Terminal.Get())
+		{
+			Result.Add(Live);
+		}
+	}
+	return Result;
+}
+
+// ========================================
+// SHARED GRIDS
+// ========================================
+
+/**
+ * Copies the cached grid into the store (sharing its data), generating and
+ * caching it first if this key hasn't been built yet.
+ */
+void UTerminalSubsystem::AcquireGrid(int32 Seed, int32 Width, int32 Height, ETerminalGridMode Mode, FTerminalGridStore& OutStore)
+{
+	const FTerminalGridKey Key{ Seed, Width, Height, Mode };
+
+	if (const FTerminalGridStore* Cached = GridCache.Find(Key))
+	{
+		UE_LOG(LogTerminal, Verbose, TEXT("Sharing cached grid (seed %d, %dx%d)"), Seed, Width, Height);
+		OutStore = *Cached;
+		return;
+	}
+
+	FTerminalGridStore& NewGrid = GridCache.Add(Key);
+	NewGrid.Generate(Width, Height, Mode, Seed);
+	OutStore = NewGrid;
+}
+
+/**
+ * Adds an untouched grid to the cache.
+ */
+void UTerminalSubsystem::ShareGrid(const FTerminalGridStore& Store)
+{
+	// Only a pristine grid matches what every other terminal would generate
+	if (Store.Num() == 0 || !Store.IsPristine())
+	{
+		return;
+	}
+
+	const FTerminalGridKey Key{ Store.GetSeed(), Store.GetWidth(), Store.GetHeight(), Store.GetMode() };
+	if (!GridCache.Contains(Key))
+	{
+		GridCache.Add(Key, Store);
+	}
+}
+
+/**
+ * Sums the grid stores of all terminals.
+ * Shared grid data is counted once per terminal using it, like GetAllocatedSize.
+ */
+void UTerminalSubsystem::UpdateGridStats() const
+{
+#if STATS
+	int64 TotalBytes = 0;
+	int64 LargestBytes = 0;
+	int64 ActiveBytes = 0;
+	int32 TerminalCount = 0;
+
+	for (const TWeakObjectPtr<ATerminalActor>& Terminal : Terminals)
+	{
+		if (const ATerminalActor* Resolved = Terminal.Get())
+		{
+			const int64 Bytes = (int64)Resolved->GridStore.GetAllocatedSize();
+			TotalBytes += Bytes;
+			LargestBytes = FMath::Max(LargestBytes, Bytes);
+			if (Resolved == ActiveTerminal.Get())
+			{
+				ActiveBytes = Bytes;
+			}
+			++TerminalCount;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_TerminalCount, TerminalCount);
+	SET_MEMORY_STAT(STAT_TerminalGridMemory, TotalBytes);
+	SET_MEMORY_STAT(STAT_TerminalGridMemoryLargest, LargestBytes);
+	SET_MEMORY_STAT(STAT_TerminalGridMemoryActive, ActiveBytes);
+#endif
+}
+
+/**
+ * Removes cache entries whose data is no longer referenced by any terminal.
+ */
+void UTerminalSubsystem::TrimGridCache()
+{
+	for (auto It = GridCache.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsDataShared())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
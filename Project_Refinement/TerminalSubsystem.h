@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TerminalGridStore.h"
+#include "TerminalSubsystem.generated.h"
+
+class ATerminalActor;
+
+/**
+ * Identifies one generated grid: terminals with the same key see the same map.
+ */
+struct FTerminalGridKey
+{
+	int32 Seed = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+	ETerminalGridMode Mode = ETerminalGridMode::Eager;
+
+	bool operator==(const FTerminalGridKey& Other) const
+	{
+		return Seed == Other.Seed && Width == Other.Width && Height == Other.Height && Mode == Other.Mode;
+	}
+
+	friend uint32 GetTypeHash(const FTerminalGridKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.Seed), GetTypeHash(Key.Width));
+		Hash = HashCombine(Hash, GetTypeHash(Key.Height));
+		return HashCombine(Hash, GetTypeHash((uint8)Key.Mode));
+	}
+};
+
+/**
+ * Terminal Manager - coordinates every ATerminalActor in a world.
+ *
+ * Levels place many terminals but the player only ever works at one of them.
+ * The subsystem:
+ * - Keeps a registry of all terminals so they can be found without actor iterators
+ * - Caches generated grids by (seed, size, mode) so terminals with the same seed
+ *   share one copy of the map data; a terminal's first write to it makes a
+ *   private copy (see FTerminalGridStore)
+ * - Keeps every terminal except the active one dormant: no timers, and its
+ *   viewport and grid buffers released shortly after it goes to sleep
+ *
+ * Terminals register themselves in BeginPlay and unregister in EndPlay.
+ * APlayerCharacter::Interact activates the terminal the player sits at.
+ */
+UCLASS()
+class PROJECT_REFINEMENT_API UTerminalSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// ========================================
+	// Registry
+	// ========================================
+
+	/**
+	 * Adds a terminal to the registry. Every terminal except the active one is sent to sleep.
+	 *
+	 * @param Terminal - Terminal that just began play
+	 */
+	void RegisterTerminal(ATerminalActor* Terminal);
+
+	/**
+	 * Removes a terminal from the registry and drops grid cache entries nobody uses anymore.
+	 *
+	 * @param Terminal - Terminal that is ending play
+	 */
+	void UnregisterTerminal(ATerminalActor* Terminal);
+
+	/**
+	 * Makes a terminal the active one: wakes it and puts the previously active terminal to sleep.
+	 * Pass nullptr to put every terminal to sleep (player walked away).
+	 *
+	 * @param Terminal - Terminal the player is now using, or nullptr
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Terminal|Manager")
+	void SetActiveTerminal(ATerminalActor* Terminal);
+
+	/** Terminal the player is currently using, or nullptr */
+	UFUNCTION(BlueprintPure, Category = "Terminal|Manager")
+	ATerminalActor* GetActiveTerminal() const { return ActiveTerminal.Get(); }
+
+	/** All registered terminals (stale entries are skipped) */
+	UFUNCTION(BlueprintPure, Category = "Terminal|Manager")
+	TArray<ATerminalActor*> GetTerminals() const;
+
+	/** Registered terminals without building a new array (entries may be stale) */
+	const TArray<TWeakObjectPtr<ATerminalActor>>& GetRegisteredTerminals() const { return Terminals; }
+
+	// ========================================
+	// Shared Grids
+	// ========================================
+
+	/**
+	 * Fills a grid store for a day, reusing the cached map if another terminal
+	 * already generated the same (seed, size, mode). The store shares the cached
+	 * data until its first write.
+	 *
+	 * @param OutStore - Store to fill (its previous contents are released)
+	 */
+	void AcquireGrid(int32 Seed, int32 Width, int32 Height, ETerminalGridMode Mode, FTerminalGridStore& OutStore);
+
+	/**
+	 * Offers an untouched grid (e.g. one prebuilt on a worker) to the cache so
+	 * other terminals with the same seed can share it. Ignored if already cached.
+	 */
+	void ShareGrid(const FTerminalGridStore& Store);
+
+	/** Drops cached grids that no terminal references anymore (run whenever a terminal's grid is replaced or released) */
+	void TrimGridCache();
+
+	/** Number of distinct grids currently cached */
+	int32 GetCachedGridCount() const { return GridCache.Num(); }
+
+	/**
+	 * Recomputes the terminal count and grid memory stats (`stat Terminal`) from
+	 * every registered terminal. Called whenever a grid is built or released.
+	 * Does nothing when stats are compiled out.
+	 */
+	void UpdateGridStats() const;
+
+private:
+	/** Every terminal that began play in this world */
+	TArray<TWeakObjectPtr<ATerminalActor>> Terminals;
+
+	/** Terminal the player is seated at */
+	TWeakObjectPtr<ATerminalActor> ActiveTerminal;
+
+	/** Pristine generated grids; terminals hold copies that share the data */
+	TMap<FTerminalGridKey, FTerminalGridStore> GridCache;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Wrap policies for torus coordinates (the map wraps at every edge).
+ *
+ * Loops that wrap many coordinates per query are templated on a policy and pick
+ * it once up front (DispatchTerminalWrap), so every wrap inside the loop inlines
+ * to a single mask or a modulo - no per-tile branch and no indirect call.
+ */
+struct FTerminalWrapModulo
+{
+	explicit FTerminalWrapModulo(int32 InSize)
+		: Size(InSize)
+	{
+	}
+
+	/** Any axis size; handles negatives */
+	FORCEINLINE int32 operator()(int32 Value) const
+	{
+		const int32 Wrapped = Value % Size;
+		return Wrapped < 0 ? Wrapped + Size : Wrapped;
+	}
+
+	int32 Size;
+};
+
+struct FTerminalWrapMasked
+{
+	explicit FTerminalWrapMasked(int32 InSize)
+		: Mask(InSize - 1)
+	{
+	}
+
+	/** Power-of-two axis sizes; two's complement makes negatives wrap correctly too */
+	FORCEINLINE int32 operator()(int32 Value) const
+	{
+		return Value & Mask;
+	}
+
+	int32 Mask;
+};
+
+/**
+ * Calls Func(WrapX, WrapY) with the wrap policies for a Width x Height map:
+ * FTerminalWrapMasked when both sizes are powers of two, FTerminalWrapModulo otherwise.
+ * Both branches must return the same type.
+ */
+template<typename FuncType>
+FORCEINLINE decltype(auto) DispatchTerminalWrap(int32 Width, int32 Height, FuncType&& Func)
+{
+	if (FMath::IsPowerOfTwo(Width) && FMath::IsPowerOfTwo(Height))
+	{
+		return Func(FTerminalWrapMasked(Width), FTerminalWrapMasked(Height));
+	}
+	return Func(FTerminalWrapModulo(Width), FTerminalWrapModulo(Height));
+}
+
+/** Same as DispatchTerminalWrap, for a single axis: Func(Wrap) */
+template<typename FuncType>
+FORCEINLINE decltype(auto) DispatchTerminalWrapAxis(int32 Size, FuncType&& Func)
+{
+	if (FMath::IsPowerOfTwo(Size))
+	{
+		return Func(FTerminalWrapMasked(Size));
+	}
+	return Func(FTerminalWrapModulo(Size));
+}